@@ -0,0 +1,196 @@
+// ----------------------------------------
+// Class: DCEL Autotuner source
+// ----------------------------------------
+
+// Include header
+#include "DCAutotuner.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "DCCacheMetrics.h"
+#include "DCStripCache.h"
+
+// Tuning file tag - bumped when the tuned fields change
+#define DC_TUNE_TAG "DCTune1"
+
+// ----------------------------------------
+// Options
+// ----------------------------------------
+
+// Constructor - default candidates
+DCTuneOptions::DCTuneOptions()
+{
+	strategies.push_back(DC_STRATEGY_GREEDY);
+	strategies.push_back(DC_STRATEGY_CACHE);
+	strategies.push_back(DC_STRATEGY_LOOKAHEAD);
+	strategies.push_back(DC_STRATEGY_TREE);
+
+	maxLengths.push_back(16);
+	maxLengths.push_back(32);
+	maxLengths.push_back(64);
+	maxLengths.push_back(128);
+	maxLengths.push_back(500);
+
+	cacheSizes.push_back(8);
+	cacheSizes.push_back(12);
+	cacheSizes.push_back(16);
+	cacheSizes.push_back(24);
+	cacheSizes.push_back(32);
+
+	cacheType = DC_CACHE_FIFO;
+	cacheSize = 16;
+
+	indexWeight = 1;
+	stripWeight = 1;
+	acmrWeight = 1;
+
+	threads = 0;
+}
+
+// ----------------------------------------
+// Autotuner
+// ----------------------------------------
+
+// Lower score first
+static bool isBetter(const DCTuneResult& result1, const DCTuneResult& result2)
+{
+	return result1.score < result2.score;
+}
+
+// Tune - one candidate per strategy, maxLength and cache size, spread over the threads
+void DCAutotuner::tune(const DCMeshDef& meshDef, const DCTuneOptions& options, std::vector<DCTuneResult>& results)
+{
+	results.clear();
+
+	for(unsigned int i = 0; i < options.strategies.size(); ++i)
+	{
+		for(unsigned int j = 0; j < options.maxLengths.size(); ++j)
+		{
+			DCTuneResult result;
+			result.settings = options.base;
+			result.settings.strategy = options.strategies[i];
+			result.settings.maxLength = options.maxLengths[j];
+			result.indices = 0;
+			result.strips = 0;
+			result.acmr = 0;
+			result.score = 0;
+
+			if(options.strategies[i] != DC_STRATEGY_CACHE)
+			{
+				results.push_back(result);
+				continue;
+			}
+
+			for(unsigned int k = 0; k < options.cacheSizes.size(); ++k)
+			{
+				result.settings.cacheType = options.cacheType;
+				result.settings.cacheSize = options.cacheSizes[k];
+				results.push_back(result);
+			}
+		}
+	}
+
+	unsigned int numThreads = options.threads ? options.threads : std::thread::hardware_concurrency();
+
+	if(numThreads < 1)
+		numThreads = 1;
+
+	if(numThreads > results.size())
+		numThreads = results.size();
+
+	// Candidate i runs on thread i % numThreads
+	std::vector<std::thread> workers;
+
+	for(unsigned int i = 1; i < numThreads; ++i)
+		workers.push_back(std::thread(&DCAutotuner::runCandidates, &meshDef, &options, &results, i, numThreads));
+
+	runCandidates(&meshDef, &options, &results, 0, numThreads);
+
+	for(unsigned int i = 0; i < workers.size(); ++i)
+		workers[i].join();
+
+	std::stable_sort(results.begin(), results.end(), isBetter);
+}
+
+// Run candidates - stripify and score every step-th candidate from first
+void DCAutotuner::runCandidates(const DCMeshDef* meshDef, const DCTuneOptions* options, std::vector<DCTuneResult>* results, unsigned int first, unsigned int step)
+{
+	for(unsigned int i = first; i < results->size(); i += step)
+	{
+		DCTuneResult& result = (*results)[i];
+
+		DCStripifier stripifier(result.settings);
+		stripifier.loadMesh(*meshDef);
+		stripifier.build();
+
+		DCCacheReport report = DCCacheMetrics::measure(stripifier, options->cacheType, options->cacheSize);
+		float faces = stripifier.getModel().getNumFaces() ? (float)stripifier.getModel().getNumFaces() : 1;
+
+		result.indices = stripifier.getIndices().size();
+		result.strips = report.strips;
+		result.acmr = report.acmr;
+		result.score = options->indexWeight * result.indices / faces + options->stripWeight * result.strips / faces + options->acmrWeight * result.acmr;
+	}
+}
+
+// Make key - the strip cache key of the bytes with default settings
+unsigned long long DCAutotuner::makeKey(const std::vector<char>& modelBytes)
+{
+	return DCStripCache::makeKey(modelBytes, DCStripSettings());
+}
+
+// Save - tag, key, then one tuned field per line
+bool DCAutotuner::save(std::ostream& out, unsigned long long key, const DCStripSettings& settings)
+{
+	out << DC_TUNE_TAG << std::endl;
+	out << "key " << DCStripCache::getKeyName(key) << std::endl;
+	out << "strategy " << settings.strategy << std::endl;
+	out << "maxLength " << settings.maxLength << std::endl;
+	out << "cacheType " << settings.cacheType << std::endl;
+	out << "cacheSize " << settings.cacheSize << std::endl;
+	out << "lookAhead " << settings.lookAhead << std::endl;
+
+	return out.good();
+}
+
+// Load - every field must be present; settings are only changed on success
+bool DCAutotuner::load(std::istream& in, unsigned long long key, DCStripSettings& settings)
+{
+	std::string tag, name, entryKey;
+	unsigned int strategy, maxLength, cacheType, cacheSize, lookAhead;
+
+	in >> tag >> name >> entryKey;
+
+	if(!in || tag != DC_TUNE_TAG || name != "key" || entryKey != DCStripCache::getKeyName(key))
+		return false;
+
+	in >> name >> strategy;
+	if(!in || name != "strategy" || strategy > DC_STRATEGY_TREE)
+		return false;
+
+	in >> name >> maxLength;
+	if(!in || name != "maxLength" || !maxLength)
+		return false;
+
+	in >> name >> cacheType;
+	if(!in || name != "cacheType" || cacheType > DC_CACHE_LRU)
+		return false;
+
+	in >> name >> cacheSize;
+	if(!in || name != "cacheSize")
+		return false;
+
+	in >> name >> lookAhead;
+	if(!in || name != "lookAhead")
+		return false;
+
+	settings.strategy = (DCStripStrategy)strategy;
+	settings.maxLength = maxLength;
+	settings.cacheType = (DCCacheType)cacheType;
+	settings.cacheSize = cacheSize;
+	settings.lookAhead = lookAhead;
+
+	return true;
+}
@@ -0,0 +1,88 @@
+// ----------------------------------------
+// Class:		DCEL Autotuner
+// Description:	Picks the strip growth settings of one mesh
+//				by stripifying it with each candidate
+// ----------------------------------------
+
+#pragma once
+#ifndef DCAUTOTUNER
+#define DCAUTOTUNER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <iostream>
+#include <vector>
+
+#include "DCStripifier.h"
+
+// ----------------------------------------
+
+// Tuning file extension - saved next to the model
+#define DC_TUNE_EXTENSION ".dctune"
+
+// Candidates and scoring
+struct DCTuneOptions
+{
+	DCStripSettings base; // Settings left as they are - layout, textures, index format
+
+	// Candidates - every strategy with every maxLength; the cache strategy also with every cache size
+	std::vector<DCStripStrategy> strategies;
+	std::vector<unsigned int> maxLengths;
+	std::vector<unsigned int> cacheSizes;
+
+	// Target cache - ACMR is simulated on it
+	DCCacheType cacheType;
+	unsigned int cacheSize;
+
+	// Score weights - per face indices, per face strips (draws, cuts or stitches) and ACMR
+	float indexWeight;
+	float stripWeight;
+	float acmrWeight;
+
+	unsigned int threads; // Candidates stripified at once - 0 for the hardware thread count
+
+	DCTuneOptions();
+};
+
+// One stripified candidate - lower scores are better
+struct DCTuneResult
+{
+	DCStripSettings settings;
+	unsigned int indices;
+	unsigned int strips;
+	float acmr;
+	float score;
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Each candidate loads its own DCEL, so candidates run on separate
+// threads without sharing state. The tuning file holds the strategy,
+// maxLength, cache settings and look-ahead of the winner with the key of
+// the model bytes; a file saved for other bytes is not loaded.
+class DCAutotuner
+{
+// ----------------------------------------
+private:
+	// Methods ----------------------------
+	static void runCandidates(const DCMeshDef* meshDef, const DCTuneOptions* options, std::vector<DCTuneResult>* results, unsigned int first, unsigned int step);
+
+// ----------------------------------------
+public:
+
+	// Stripifies every candidate - results sorted best first
+	static void tune(const DCMeshDef& meshDef, const DCTuneOptions& options, std::vector<DCTuneResult>& results);
+
+	// Key of the model file bytes
+	static unsigned long long makeKey(const std::vector<char>& modelBytes);
+
+	// Tuning file - the tuned fields are written, and read over the given settings
+	static bool save(std::ostream& out, unsigned long long key, const DCStripSettings& settings);
+	static bool load(std::istream& in, unsigned long long key, DCStripSettings& settings);
+};
+// ----------------------------------------
+
+#endif
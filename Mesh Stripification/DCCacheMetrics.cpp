@@ -0,0 +1,123 @@
+// ----------------------------------------
+// Class: DCEL Cache Metrics source
+// ----------------------------------------
+
+// Include header
+#include "DCCacheMetrics.h"
+
+#include "DCIndexStream.h"
+
+// ----------------------------------------
+// Report
+// ----------------------------------------
+
+// Constructor
+DCCacheReport::DCCacheReport()
+{
+	cacheType = DC_CACHE_FIFO;
+	cacheSize = 0;
+
+	indices = 0;
+	triangles = 0;
+	vertices = 0;
+	strips = 0;
+	draws = 0;
+	swaps = 0;
+	misses = 0;
+
+	acmr = 0;
+	atvr = 0;
+
+	fetchLines = 0;
+	fetchDistance = 0;
+}
+
+// ----------------------------------------
+// Metrics
+// ----------------------------------------
+
+// Measure - index stream
+DCCacheReport DCCacheMetrics::measure(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips, DCCacheType type, unsigned int size)
+{
+	DCCacheReport report;
+	DCVertexCache cache(type, size);
+
+	report.cacheType = type;
+	report.cacheSize = cache.getSize();
+	report.indices = indices.size();
+	report.draws = drawCounts.size();
+
+	// Simulate the cache - distinct vertices are marked as they are seen
+	std::vector<bool> seen;
+
+	// Fetches on cache misses
+	DCVertexCache lines(DC_CACHE_LRU, DC_FETCH_LINES);
+	unsigned int lastFetch = 0;
+	double distance = 0;
+
+	for(unsigned int i = 0; i < indices.size(); ++i)
+	{
+		if(strips && indices[i] == DC_STRIP_CUT_32)
+			continue;
+
+		if(!cache.access(indices[i]))
+		{
+			lines.access((unsigned int)((unsigned long long)indices[i] * sizeof(DCStripVertex) / DC_FETCH_LINE_SIZE));
+
+			if(cache.getMisses() > 1)
+				distance += indices[i] > lastFetch ? indices[i] - lastFetch : lastFetch - indices[i];
+
+			lastFetch = indices[i];
+		}
+
+		if(indices[i] >= seen.size())
+			seen.resize(indices[i] + 1, false);
+
+		if(!seen[indices[i]])
+		{
+			seen[indices[i]] = true;
+			report.vertices += 1;
+		}
+	}
+
+	report.misses = cache.getMisses();
+	report.fetchLines = lines.getMisses();
+
+	if(report.misses > 1)
+		report.fetchDistance = (float)(distance / (report.misses - 1));
+
+	// Drawn triangles
+	if(strips)
+	{
+		std::vector<unsigned int> triangles;
+		DCIndexStream::expandStrips(indices, drawCounts, DC_STRIP_CUT_32, triangles);
+
+		report.triangles = triangles.size() / 3;
+	}
+	else
+		report.triangles = indices.size() / 3;
+
+	if(report.triangles)
+		report.acmr = (float)report.misses / report.triangles;
+
+	if(report.vertices)
+		report.atvr = (float)report.misses / report.vertices;
+
+	return report;
+}
+
+// Measure - stripifier output
+DCCacheReport DCCacheMetrics::measure(const DCStripifier& stripifier, DCCacheType type, unsigned int size)
+{
+	bool strips = stripifier.getSettings().stripify;
+
+	DCCacheReport report = measure(stripifier.getIndices(), stripifier.getDrawCounts(), strips, type, size);
+
+	if(strips)
+	{
+		report.strips = stripifier.getNumStrips();
+		report.swaps = stripifier.getNumSwaps();
+	}
+
+	return report;
+}
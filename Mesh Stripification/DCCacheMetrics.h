@@ -0,0 +1,67 @@
+// ----------------------------------------
+// Class:		DCEL Cache Metrics
+// Description:	Vertex cache quality of an index stream
+// ----------------------------------------
+
+#pragma once
+#ifndef DCCACHEMETRICS
+#define DCCACHEMETRICS
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+#include "DCStripifier.h"
+#include "DCVertexCache.h"
+
+// ----------------------------------------
+
+// Vertex fetch simulation - memory line size in bytes, lines held
+#define DC_FETCH_LINE_SIZE 64
+#define DC_FETCH_LINES 16
+
+// Measured quality of one index stream
+struct DCCacheReport
+{
+	DCCacheType cacheType;
+	unsigned int cacheSize;
+
+	unsigned int indices; // Index count, including cuts and degenerates
+	unsigned int triangles; // Drawn (non-degenerate) triangles
+	unsigned int vertices; // Distinct vertices referenced
+	unsigned int strips; // Strips - 0 for triangle lists
+	unsigned int draws; // Draw calls
+	unsigned int swaps; // Swap indices inside strips
+	unsigned int misses; // Vertices transformed
+
+	float acmr; // Average cache miss ratio - misses per triangle
+	float atvr; // Average transform to vertex ratio - misses per distinct vertex
+
+	// Vertex fetch - over cache misses, DCStripVertex sized vertices
+	unsigned int fetchLines; // Memory lines read through an LRU of DC_FETCH_LINES lines
+	float fetchDistance; // Average distance in vertices between consecutive fetches
+
+	DCCacheReport();
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// The cache is simulated over the index stream in submission order and
+// is not flushed between draws. Strip cut indices are not transformed.
+class DCCacheMetrics
+{
+// ----------------------------------------
+public:
+
+	// Measure a raw index stream - strips are expanded to count drawn triangles
+	static DCCacheReport measure(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips, DCCacheType type, unsigned int size);
+
+	// Measure the output of a stripifier
+	static DCCacheReport measure(const DCStripifier& stripifier, DCCacheType type, unsigned int size);
+};
+// ----------------------------------------
+
+#endif
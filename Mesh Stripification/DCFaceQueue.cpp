@@ -0,0 +1,173 @@
+// ----------------------------------------
+// Class: DCEL Face Queue source
+// ----------------------------------------
+
+// Include header
+#include "DCFaceQueue.h"
+
+// Bits per bucket word
+#define DC_WORD_BITS 64
+
+// Constructor
+DCFaceQueue::DCFaceQueue()
+{
+	lowest = 0;
+	size = 0;
+}
+
+// Destructor
+DCFaceQueue::~DCFaceQueue()
+{
+	// Empty
+}
+
+// Setup - clears and sizes the buckets
+void DCFaceQueue::setup(unsigned int numFaces, int maxDegree)
+{
+	unsigned int numBuckets = (maxDegree > 0 ? maxDegree : 0) + 1;
+	unsigned int numWords = (numFaces + DC_WORD_BITS - 1) / DC_WORD_BITS;
+
+	buckets.assign(numBuckets, std::vector<unsigned long long>(numWords, 0));
+	cursors.assign(numBuckets, numWords);
+	counts.assign(numBuckets, 0);
+	bucketOf.assign(numFaces, -1);
+	positions.clear();
+	order.clear();
+
+	lowest = numBuckets;
+	size = 0;
+}
+
+// Set order - the position of each face is its index in the order
+void DCFaceQueue::setOrder(const std::vector<unsigned int>& order)
+{
+	this->order = order;
+	positions.resize(order.size());
+
+	for(unsigned int i = 0; i < order.size(); ++i)
+		positions[order[i]] = i;
+}
+
+// Clamp degree to a bucket index
+unsigned int DCFaceQueue::toBucket(int degree) const
+{
+	if(degree < 0)
+		return 0;
+
+	if((unsigned int)degree >= buckets.size())
+		return buckets.size() - 1;
+
+	return degree;
+}
+
+// Bit position of a face
+unsigned int DCFaceQueue::toPosition(unsigned int faceId) const
+{
+	return positions.empty() ? faceId : positions[faceId];
+}
+
+// Push - add a face to the bucket for its degree
+void DCFaceQueue::push(unsigned int faceId, int degree)
+{
+	unsigned int bucket = toBucket(degree);
+	unsigned int position = toPosition(faceId);
+	unsigned int word = position / DC_WORD_BITS;
+
+	buckets[bucket][word] |= (1ULL << (position % DC_WORD_BITS));
+	bucketOf[faceId] = bucket;
+
+	// Moving the cursor back keeps the lowest position reachable
+	if(word < cursors[bucket])
+		cursors[bucket] = word;
+
+	if(bucket < lowest)
+		lowest = bucket;
+
+	counts[bucket] += 1;
+	size += 1;
+}
+
+// Remove - take a face out of its bucket
+void DCFaceQueue::remove(unsigned int faceId)
+{
+	if(bucketOf[faceId] < 0)
+		return;
+
+	unsigned int bucket = bucketOf[faceId];
+	unsigned int position = toPosition(faceId);
+
+	buckets[bucket][position / DC_WORD_BITS] &= ~(1ULL << (position % DC_WORD_BITS));
+	bucketOf[faceId] = -1;
+
+	counts[bucket] -= 1;
+	size -= 1;
+}
+
+// Update - move a face to the bucket for its new degree
+void DCFaceQueue::update(unsigned int faceId, int degree)
+{
+	if(bucketOf[faceId] < 0)
+		return;
+
+	if((unsigned int)bucketOf[faceId] == toBucket(degree))
+		return;
+
+	remove(faceId);
+	push(faceId, degree);
+}
+
+// Get min - lowest degree, then lowest face id or position
+unsigned int DCFaceQueue::getMin()
+{
+	if(!size)
+		return DC_NO_FACE;
+
+	// Skip empty buckets - lowest only moves back when a face is pushed
+	while(counts[lowest] == 0)
+		++lowest;
+
+	std::vector<unsigned long long>& bucket = buckets[lowest];
+	unsigned int& word = cursors[lowest];
+
+	// Advance the cursor over empty words
+	while(!bucket[word])
+		++word;
+
+	// Find the lowest set bit in the word
+	unsigned long long bits = bucket[word];
+	unsigned int bit = 0;
+
+	while(!(bits & 1ULL))
+	{
+		bits >>= 1;
+		++bit;
+	}
+
+	unsigned int position = word * DC_WORD_BITS + bit;
+
+	return order.empty() ? position : order[position];
+}
+
+// Contains - is the face queued
+bool DCFaceQueue::contains(unsigned int faceId) const
+{
+	return bucketOf[faceId] >= 0;
+}
+
+// Is empty
+bool DCFaceQueue::isEmpty() const
+{
+	return size == 0;
+}
+
+// Get bytes
+unsigned long long DCFaceQueue::getBytes() const
+{
+	unsigned long long bytes = cursors.capacity() * sizeof(unsigned int) + counts.capacity() * sizeof(unsigned int) + bucketOf.capacity() * sizeof(int) +
+		(positions.capacity() + order.capacity()) * sizeof(unsigned int);
+
+	for(unsigned int i = 0; i < buckets.size(); ++i)
+		bytes += buckets[i].capacity() * sizeof(unsigned long long);
+
+	return bytes;
+}
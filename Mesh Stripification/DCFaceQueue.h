@@ -0,0 +1,89 @@
+// ----------------------------------------
+// Class:		DCEL Face Queue
+// Description:	Degree-indexed bucket queue of free faces
+// ----------------------------------------
+
+#pragma once
+#ifndef DCFACEQUEUE
+#define DCFACEQUEUE
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+// ----------------------------------------
+
+// Returned when the queue holds no faces
+#define DC_NO_FACE 0xFFFFFFFF
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Each degree has its own bucket, stored as a bitset over the face ids.
+// The lowest free face is found by scanning the lowest non-empty bucket
+// from its cursor - faces are always returned lowest degree first, then
+// lowest face id first, matching a linear scan of the face array. With an
+// order set, the bits are positions in that order instead of face ids.
+class DCFaceQueue
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	// Bucket bitsets - one bit per face id
+	std::vector< std::vector<unsigned long long> > buckets;
+
+	// Per bucket - first word that may hold a set bit
+	std::vector<unsigned int> cursors;
+
+	// Per bucket - number of faces held
+	std::vector<unsigned int> counts;
+
+	// Per face - bucket it is held in (-1 if not queued)
+	std::vector<int> bucketOf;
+
+	// Per face - bit position, and the face at each position; empty for face id order
+	std::vector<unsigned int> positions;
+	std::vector<unsigned int> order;
+
+	// Lowest bucket that may be non-empty
+	unsigned int lowest;
+
+	// Total number of faces held
+	unsigned int size;
+
+	// Methods ----------------------------
+	// Clamp a degree to a valid bucket
+	unsigned int toBucket(int degree) const;
+	unsigned int toPosition(unsigned int faceId) const;
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCFaceQueue();
+	~DCFaceQueue();
+
+	// Clears the queue and sizes it for numFaces faces with degrees 0 to maxDegree
+	void setup(unsigned int numFaces, int maxDegree);
+
+	// Faces of equal degree are returned in this order rather than by id - set before pushing
+	void setOrder(const std::vector<unsigned int>& order);
+
+	// Queue operations
+	void push(unsigned int faceId, int degree);
+	void remove(unsigned int faceId);
+	void update(unsigned int faceId, int degree); // Degree has changed
+
+	// Returns the free face with the lowest degree - DC_NO_FACE if empty
+	unsigned int getMin();
+
+	// Getters
+	bool contains(unsigned int faceId) const;
+	bool isEmpty() const;
+	unsigned long long getBytes() const; // Memory held by the buckets and per-face tables
+};
+// ----------------------------------------
+
+#endif
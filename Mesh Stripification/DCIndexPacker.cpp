@@ -0,0 +1,270 @@
+// ----------------------------------------
+// Class: DCEL Index Packer source
+// ----------------------------------------
+
+// Include header
+#include "DCIndexPacker.h"
+
+#include "DCStripifier.h"
+
+#include <algorithm>
+
+// ----------------------------------------
+// Packed indices
+// ----------------------------------------
+
+// Constructor
+DCPackedIndices::DCPackedIndices()
+{
+	format = DC_INDEX_32;
+	chunked = false;
+}
+
+unsigned int DCPackedIndices::getIndexSize() const
+{
+	return format == DC_INDEX_16 ? sizeof(unsigned short) : sizeof(unsigned int);
+}
+
+unsigned int DCPackedIndices::getNumIndices() const
+{
+	return format == DC_INDEX_16 ? indices16.size() : indices32.size();
+}
+
+unsigned int DCPackedIndices::getBytes() const
+{
+	return getNumIndices() * getIndexSize();
+}
+
+// ----------------------------------------
+// Packer
+// ----------------------------------------
+
+// Chunk being filled - absolute vertex ids and their range
+struct DCIndexChunk
+{
+	std::vector<unsigned int> indices;
+	unsigned int low;
+	unsigned int high;
+
+	void clear()
+	{
+		indices.clear();
+		low = 0xFFFFFFFF;
+		high = 0;
+	}
+
+	void add(unsigned int index, bool strips)
+	{
+		indices.push_back(index);
+
+		if(strips && index == DC_STRIP_CUT_32)
+			return;
+
+		if(index < low)
+			low = index;
+
+		if(index > high)
+			high = index;
+	}
+
+	// Does index keep the range within vertices
+	bool fits(unsigned int index, unsigned int vertices) const
+	{
+		unsigned int newLow = index < low ? index : low;
+		unsigned int newHigh = index > high ? index : high;
+
+		return newHigh - newLow < vertices;
+	}
+};
+
+// Flush a chunk as one draw rebased on its lowest vertex
+static void flushChunk(DCIndexChunk& chunk, bool strips, unsigned int sourceDraw, DCPackedIndices& packed)
+{
+	if(chunk.indices.empty())
+		return;
+
+	DCIndexDraw draw;
+	draw.startIndex = packed.indices16.size();
+	draw.indexCount = chunk.indices.size();
+	draw.baseVertex = chunk.low;
+	draw.draw = sourceDraw;
+
+	for(unsigned int i = 0; i < chunk.indices.size(); ++i)
+	{
+		if(strips && chunk.indices[i] == DC_STRIP_CUT_32)
+			packed.indices16.push_back(DC_STRIP_CUT_16);
+		else
+			packed.indices16.push_back((unsigned short)(chunk.indices[i] - chunk.low));
+	}
+
+	packed.draws.push_back(draw);
+	chunk.clear();
+}
+
+// Chunk stream - false if a triangle spans more than chunkVertices vertices
+static bool chunkStream(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips,
+	DCPackedIndices& packed, unsigned int chunkVertices)
+{
+	DCIndexChunk chunk;
+	chunk.clear();
+
+	unsigned int start = 0;
+
+	for(unsigned int i = 0; i < drawCounts.size(); ++i)
+	{
+		unsigned int end = start + drawCounts[i];
+		unsigned int stripStart = start; // First index after the last cut
+
+		for(unsigned int j = start; j < end; ++j)
+		{
+			unsigned int index = indices[j];
+
+			if(strips && index == DC_STRIP_CUT_32)
+			{
+				chunk.add(index, strips);
+				stripStart = j + 1;
+				continue;
+			}
+
+			if(!chunk.fits(index, chunkVertices))
+			{
+				// Restart on the triangle's first indices
+				unsigned int first;
+
+				if(strips)
+					first = j - stripStart >= 2 ? j - 2 : stripStart;
+				else
+				{
+					first = j - (j - start) % 3;
+
+					// A list chunk ends on a whole triangle
+					chunk.indices.resize(chunk.indices.size() - (j - first));
+				}
+
+				flushChunk(chunk, strips, i, packed);
+
+				// Odd strip triangles are padded to keep their winding
+				if(strips && (first - stripStart) % 2)
+					chunk.add(indices[first], strips);
+
+				for(unsigned int k = first; k < j; ++k)
+					chunk.add(indices[k], strips);
+
+				if(!chunk.fits(index, chunkVertices))
+					return false;
+			}
+
+			chunk.add(index, strips);
+		}
+
+		flushChunk(chunk, strips, i, packed);
+		start = end;
+	}
+
+	return true;
+}
+
+// Set draws - one per draw of the stream, index for index
+static void setDraws(const std::vector<unsigned int>& drawCounts, DCPackedIndices& packed)
+{
+	packed.draws.clear();
+
+	unsigned int start = 0;
+
+	for(unsigned int i = 0; i < drawCounts.size(); ++i)
+	{
+		DCIndexDraw draw;
+		draw.startIndex = start;
+		draw.indexCount = drawCounts[i];
+		draw.baseVertex = 0;
+		draw.draw = i;
+
+		packed.draws.push_back(draw);
+		start += drawCounts[i];
+	}
+}
+
+// Pack
+void DCIndexPacker::pack(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips,
+	DCIndexFormat format, DCPackedIndices& packed, unsigned int chunkVertices)
+{
+	packed.format = format;
+	packed.chunked = false;
+	packed.indices16.clear();
+	packed.indices32.clear();
+	packed.draws.clear();
+
+	if(chunkVertices > DC_INDEX_CHUNK_16)
+		chunkVertices = DC_INDEX_CHUNK_16;
+
+	// Highest vertex - cut indices excluded
+	unsigned int highest = 0;
+
+	for(unsigned int i = 0; i < indices.size(); ++i)
+		if(!(strips && indices[i] == DC_STRIP_CUT_32) && indices[i] > highest)
+			highest = indices[i];
+
+	// Split into chunks - falls back to 32-bit if a triangle can't fit one
+	if(format == DC_INDEX_16 && highest >= chunkVertices)
+	{
+		if(chunkStream(indices, drawCounts, strips, packed, chunkVertices))
+		{
+			packed.chunked = true;
+			return;
+		}
+
+		packed.format = DC_INDEX_32;
+		packed.indices16.clear();
+		packed.draws.clear();
+	}
+
+	// Whole stream in one format - draws are kept
+	setDraws(drawCounts, packed);
+
+	if(packed.format == DC_INDEX_32)
+		packed.indices32 = indices;
+	else
+	{
+		packed.indices16.resize(indices.size());
+
+		for(unsigned int i = 0; i < indices.size(); ++i)
+			packed.indices16[i] = (strips && indices[i] == DC_STRIP_CUT_32) ? DC_STRIP_CUT_16 : (unsigned short)indices[i];
+	}
+}
+
+// Patch - ranges converted as pack converts a whole stream
+bool DCIndexPacker::patch(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips,
+	const std::vector<DCIndexRange>& ranges, DCPackedIndices& packed)
+{
+	if(packed.chunked)
+		return false;
+
+	if(packed.format == DC_INDEX_32)
+	{
+		packed.indices32.resize(indices.size());
+
+		for(unsigned int i = 0; i < ranges.size(); ++i)
+			std::copy(indices.begin() + ranges[i].start, indices.begin() + ranges[i].start + ranges[i].count, packed.indices32.begin() + ranges[i].start);
+	}
+	else
+	{
+		packed.indices16.resize(indices.size());
+
+		for(unsigned int i = 0; i < ranges.size(); ++i)
+		{
+			for(unsigned int j = ranges[i].start; j < ranges[i].start + ranges[i].count; ++j)
+			{
+				if(strips && indices[j] == DC_STRIP_CUT_32)
+					packed.indices16[j] = DC_STRIP_CUT_16;
+				else if(indices[j] < DC_INDEX_CHUNK_16)
+					packed.indices16[j] = (unsigned short)indices[j];
+				else
+					return false;
+			}
+		}
+	}
+
+	setDraws(drawCounts, packed);
+
+	return true;
+}
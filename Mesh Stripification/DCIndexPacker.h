@@ -0,0 +1,86 @@
+// ----------------------------------------
+// Class:		DCEL Index Packer
+// Description:	Packs 32-bit index streams into 16-bit
+//				chunks addressed through a base vertex
+// ----------------------------------------
+
+#pragma once
+#ifndef DCINDEXPACKER
+#define DCINDEXPACKER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+// ----------------------------------------
+
+// Vertices one 16-bit chunk can address - 0xFFFF is kept for the strip cut
+#define DC_INDEX_CHUNK_16 0xFFFF
+
+// Index width
+enum DCIndexFormat
+{
+	DC_INDEX_16,
+	DC_INDEX_32
+};
+
+// Range of the index stream
+struct DCIndexRange
+{
+	unsigned int start;
+	unsigned int count;
+};
+
+// One draw of a packed stream - DrawIndexed(indexCount, startIndex, baseVertex)
+struct DCIndexDraw
+{
+	unsigned int startIndex;
+	unsigned int indexCount;
+	unsigned int baseVertex;
+	unsigned int draw; // Draw of the unpacked stream it belongs to
+};
+
+// Packed index stream - only the array matching the format is filled
+struct DCPackedIndices
+{
+	DCIndexFormat format;
+	bool chunked; // Split into 16-bit chunks - packed indices no longer line up with the stream
+	std::vector<unsigned short> indices16;
+	std::vector<unsigned int> indices32;
+	std::vector<DCIndexDraw> draws;
+
+	DCPackedIndices();
+
+	unsigned int getIndexSize() const; // Bytes per index
+	unsigned int getNumIndices() const;
+	unsigned int getBytes() const;
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// A stream whose vertices all fit in one chunk is converted as is. Larger
+// streams are split so each draw addresses fewer than chunkVertices
+// vertices above its base vertex. Triangle lists split between
+// triangles; strips restart on the last two indices of the split
+// triangle, padded with a degenerate to keep its winding. If a single
+// triangle spans more than one chunk the stream stays 32-bit.
+class DCIndexPacker
+{
+// ----------------------------------------
+public:
+
+	// Pack indices drawn as consecutive draws of drawCounts indices - strips use DC_STRIP_CUT_32 cuts
+	static void pack(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips,
+		DCIndexFormat format, DCPackedIndices& packed, unsigned int chunkVertices = DC_INDEX_CHUNK_16);
+
+	// Patch the ranges of a stream rewritten since it was packed, e.g. by an edit, and
+	// its draws - false if the stream was chunked or now needs chunks, so it must be packed again
+	static bool patch(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, bool strips,
+		const std::vector<DCIndexRange>& ranges, DCPackedIndices& packed);
+};
+// ----------------------------------------
+
+#endif
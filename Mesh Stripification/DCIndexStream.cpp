@@ -0,0 +1,64 @@
+// ----------------------------------------
+// Class: DCEL Index Stream source
+// ----------------------------------------
+
+// Include header
+#include "DCIndexStream.h"
+
+// Expand strip - one draw call
+void DCIndexStream::expandStrip(const unsigned int* indices, unsigned int count, unsigned int cutIndex, std::vector<unsigned int>& triangles)
+{
+	// Indices since the last cut
+	unsigned int stripLength = 0;
+
+	for(unsigned int i = 0; i < count; ++i)
+	{
+		// Cut - start a new strip
+		if(indices[i] == cutIndex)
+		{
+			stripLength = 0;
+			continue;
+		}
+
+		stripLength += 1;
+
+		if(stripLength < 3)
+			continue;
+
+		unsigned int a = indices[i - 2];
+		unsigned int b = indices[i - 1];
+		unsigned int c = indices[i];
+
+		// Degenerate - used for swaps and stitching, not drawn
+		if(a == b || b == c || a == c)
+			continue;
+
+		// Odd triangles are wound the other way
+		if((stripLength - 3) % 2)
+		{
+			triangles.push_back(b);
+			triangles.push_back(a);
+		}
+		else
+		{
+			triangles.push_back(a);
+			triangles.push_back(b);
+		}
+
+		triangles.push_back(c);
+	}
+}
+
+// Expand strips - consecutive draws
+void DCIndexStream::expandStrips(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, unsigned int cutIndex, std::vector<unsigned int>& triangles)
+{
+	unsigned int start = 0;
+
+	for(unsigned int i = 0; i < drawCounts.size(); ++i)
+	{
+		if(drawCounts[i])
+			expandStrip(&indices[start], drawCounts[i], cutIndex, triangles);
+
+		start += drawCounts[i];
+	}
+}
@@ -0,0 +1,35 @@
+// ----------------------------------------
+// Class:		DCEL Index Stream
+// Description:	CPU-side helpers for strip index streams
+// ----------------------------------------
+
+#pragma once
+#ifndef DCINDEXSTREAM
+#define DCINDEXSTREAM
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Expands strip index streams into triangle lists the way the input
+// assembler would - odd triangles in a strip are re-wound, degenerate
+// triangles are dropped and the strip cut index starts a new strip.
+class DCIndexStream
+{
+// ----------------------------------------
+public:
+
+	// Expand one draw of a strip stream - cutIndex splits strips inside the draw
+	static void expandStrip(const unsigned int* indices, unsigned int count, unsigned int cutIndex, std::vector<unsigned int>& triangles);
+
+	// Expand a strip stream drawn as consecutive draws of drawCounts indices
+	static void expandStrips(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& drawCounts, unsigned int cutIndex, std::vector<unsigned int>& triangles);
+};
+// ----------------------------------------
+
+#endif
@@ -17,6 +17,8 @@ VertexData::VertexData()
 	this->position.y = 0;
 	this->position.z = 0;
 
+	this->normal.set(0, 0, 0);
+
 	set = 0;
 }
 
@@ -37,14 +39,14 @@ VertexData::VertexData(float x, float y, float z)
 }
 
 // Position Setter
-// Position - GUVector4
-void VertexData::setPosition(CoreStructures::GUVector4 position)
+// Position - Vector3f
+void VertexData::setPosition(Vector3f position)
 {
 	this->position = position;
 }
 
 // Normal Setter
-void VertexData::setNormal(CoreStructures::GUVector4 normal)
+void VertexData::setNormal(Vector3f normal)
 {
 	this->normal = normal;
 }
@@ -98,6 +100,8 @@ FaceData::FaceData()
 	// Initial free setting
 	free = 1;
 	degree = 0; // No free neighbours
+	hidden = 0;
+	material = 0;
 }
 
 // Destructor
@@ -10,7 +10,8 @@
 // ----------------------------------------
 // INCLUDES
 // ----------------------------------------
-#include <CoreStructures\GUVector4.h>
+// DCEL - Vector types (portable, no CoreStructures dependency)
+#include "DCEL/Vector3.h"
 
 // ----------------------------------------
 
@@ -22,11 +23,11 @@ class VertexData
 // ----------------------------------------
 public:
 	// Attributes -------------------------
-	// Position x, y, z, w
-	CoreStructures::GUVector4 position;
+	// Position x, y, z
+	Vector3f position;
 
 	// Normals
-	CoreStructures::GUVector4 normal;
+	Vector3f normal;
 
 	// Duplication Checker variables
 	bool set;
@@ -41,10 +42,10 @@ public:
 	VertexData(float x, float y, float z);
 
 	// Position Setter
-	void setPosition(CoreStructures::GUVector4 position);
+	void setPosition(Vector3f position);
 
 	// Normal Setter
-	void setNormal(CoreStructures::GUVector4 normal);
+	void setNormal(Vector3f normal);
 
 };
 
@@ -91,6 +92,8 @@ public:
 	// Search variables
 	bool free; // Has been added to a strip
 	int degree; // Number of free trianges adjacent
+	bool hidden; // Left out of strips - removed by an edit
+	unsigned int material; // Strips never cross materials
 
 	// Methods ----------------------------
 	// Constructor & Destructor
@@ -0,0 +1,320 @@
+// ----------------------------------------
+// Class: DCEL Meshlet Builder source
+// ----------------------------------------
+
+// Include header
+#include "DCMeshletBuilder.h"
+
+#include <cmath>
+
+// ----------------------------------------
+// Meshlet
+// ----------------------------------------
+
+// Constructor
+DCMeshlet::DCMeshlet()
+{
+	vertexOffset = 0;
+	vertexCount = 0;
+	triangleOffset = 0;
+	triangleCount = 0;
+
+	center[0] = center[1] = center[2] = 0;
+	radius = 0;
+
+	coneAxis[0] = coneAxis[1] = coneAxis[2] = 0;
+	coneCutoff = -1;
+}
+
+// ----------------------------------------
+// Builder
+// ----------------------------------------
+
+// Constructor
+DCMeshletBuilder::DCMeshletBuilder()
+{
+}
+
+// Destructor
+DCMeshletBuilder::~DCMeshletBuilder()
+{
+}
+
+// Build
+void DCMeshletBuilder::build(const DCStripifier& stripifier, unsigned int maxVertices, unsigned int maxTriangles)
+{
+	const DCMesh& model = stripifier.getModel();
+	const std::vector<DCStripVertex>& stripVertices = stripifier.getVertices();
+	unsigned int numFaces = model.getNumFaces();
+
+	meshlets.clear();
+	vertices.clear();
+	triangles.clear();
+	faces.clear();
+
+	// A meshlet must hold at least one triangle
+	if(maxVertices > DC_MESHLET_MAX_VERTICES)
+		maxVertices = DC_MESHLET_MAX_VERTICES;
+
+	if(maxVertices < 3)
+		maxVertices = 3;
+
+	if(maxTriangles < 1)
+		maxTriangles = 1;
+
+	// Face centres
+	std::vector<float> centres(numFaces * 3, 0);
+
+	for(unsigned int i = 0; i < numFaces; ++i)
+		for(int j = 0; j < 3; ++j)
+			for(int k = 0; k < 3; ++k)
+				centres[i * 3 + k] += stripVertices[model.getFace(i)->getData().v[j]].pos[k] / 3;
+
+	// Local index of each output vertex in the open meshlet
+	std::vector<int> localIndex(stripVertices.size(), -1);
+	std::vector<bool> assigned(numFaces, false);
+
+	// Hidden faces are left out
+	for(unsigned int i = 0; i < numFaces; ++i)
+		assigned[i] = model.getFace(i)->getData().hidden;
+	std::vector<unsigned int> candidates;
+	unsigned int seed = 0;
+
+	while(true)
+	{
+		// Start on the last meshlet's frontier, else the lowest unassigned face
+		unsigned int start = DC_NO_FACE;
+
+		for(unsigned int i = 0; i < candidates.size() && start == DC_NO_FACE; ++i)
+			if(!assigned[candidates[i]])
+				start = candidates[i];
+
+		if(start == DC_NO_FACE)
+		{
+			while(seed < numFaces && assigned[seed])
+				++seed;
+
+			if(seed == numFaces)
+				break;
+
+			start = seed;
+		}
+
+		DCMeshlet meshlet;
+		meshlet.vertexOffset = vertices.size();
+		meshlet.triangleOffset = triangles.size() / 3;
+
+		float centre[3] = {0, 0, 0};
+
+		candidates.clear();
+		candidates.push_back(start);
+
+		while(true)
+		{
+			// Best fitting candidate - fewest new vertices, then closest to the centre
+			int selected = -1;
+			unsigned int selectedNew = 0;
+			float selectedDistance = 0;
+
+			for(unsigned int i = 0; i < candidates.size(); ++i)
+			{
+				unsigned int faceId = candidates[i];
+
+				if(assigned[faceId])
+					continue;
+
+				unsigned int newVertices = 0;
+
+				for(int j = 0; j < 3; ++j)
+					if(localIndex[model.getFace(faceId)->getData().v[j]] < 0)
+						newVertices += 1;
+
+				if(meshlet.vertexCount + newVertices > maxVertices)
+					continue;
+
+				float distance = 0;
+
+				for(int k = 0; k < 3; ++k)
+				{
+					float d = centres[faceId * 3 + k] - centre[k];
+					distance += d * d;
+				}
+
+				if(selected < 0 || newVertices < selectedNew || (newVertices == selectedNew && distance < selectedDistance))
+				{
+					selected = i;
+					selectedNew = newVertices;
+					selectedDistance = distance;
+				}
+			}
+
+			if(selected < 0)
+				break;
+
+			// Add the face
+			unsigned int faceId = candidates[selected];
+			DCMesh::Face* face = model.getFace(faceId);
+
+			assigned[faceId] = true;
+			faces.push_back(faceId);
+
+			for(int j = 0; j < 3; ++j)
+			{
+				unsigned int vertex = face->getData().v[j];
+
+				if(localIndex[vertex] < 0)
+				{
+					localIndex[vertex] = meshlet.vertexCount++;
+					vertices.push_back(vertex);
+				}
+
+				triangles.push_back((unsigned char)localIndex[vertex]);
+			}
+
+			meshlet.triangleCount += 1;
+
+			for(int k = 0; k < 3; ++k)
+				centre[k] += (centres[faceId * 3 + k] - centre[k]) / meshlet.triangleCount;
+
+			if(meshlet.triangleCount == maxTriangles)
+				break;
+
+			// Add its free neighbours
+			EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(face);
+
+			for(int j = 0; j < 3; ++j)
+			{
+				DCMesh::Face* neighbour = edgeIt.getNext()->getTwin()->getFace();
+
+				if(neighbour && !assigned[model.getFaceId(neighbour)])
+					candidates.push_back(model.getFaceId(neighbour));
+			}
+		}
+
+		// Reset local indices for the next meshlet
+		for(unsigned int i = meshlet.vertexOffset; i < vertices.size(); ++i)
+			localIndex[vertices[i]] = -1;
+
+		setupBounds(meshlet, stripifier);
+		meshlets.push_back(meshlet);
+	}
+}
+
+// Setup bounds - sphere around the vertex bounding box, cone around the average face normal
+void DCMeshletBuilder::setupBounds(DCMeshlet& meshlet, const DCStripifier& stripifier)
+{
+	const std::vector<DCStripVertex>& stripVertices = stripifier.getVertices();
+
+	// Bounding box centre
+	float minPos[3], maxPos[3];
+
+	for(int k = 0; k < 3; ++k)
+		minPos[k] = maxPos[k] = stripVertices[vertices[meshlet.vertexOffset]].pos[k];
+
+	for(unsigned int i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+	{
+		for(int k = 0; k < 3; ++k)
+		{
+			float p = stripVertices[vertices[i]].pos[k];
+
+			if(p < minPos[k])
+				minPos[k] = p;
+
+			if(p > maxPos[k])
+				maxPos[k] = p;
+		}
+	}
+
+	for(int k = 0; k < 3; ++k)
+		meshlet.center[k] = (minPos[k] + maxPos[k]) / 2;
+
+	// Radius - furthest vertex
+	float radius = 0;
+
+	for(unsigned int i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+	{
+		float distance = 0;
+
+		for(int k = 0; k < 3; ++k)
+		{
+			float d = stripVertices[vertices[i]].pos[k] - meshlet.center[k];
+			distance += d * d;
+		}
+
+		if(distance > radius)
+			radius = distance;
+	}
+
+	meshlet.radius = sqrt(radius);
+
+	// Unit face normals - degenerate faces are skipped
+	std::vector<float> normals;
+
+	for(unsigned int i = meshlet.triangleOffset; i < meshlet.triangleOffset + meshlet.triangleCount; ++i)
+	{
+		const float* p0 = stripVertices[vertices[meshlet.vertexOffset + triangles[i * 3]]].pos;
+		const float* p1 = stripVertices[vertices[meshlet.vertexOffset + triangles[i * 3 + 1]]].pos;
+		const float* p2 = stripVertices[vertices[meshlet.vertexOffset + triangles[i * 3 + 2]]].pos;
+
+		float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+		float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+		float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+
+		float length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+		if(length == 0)
+			continue;
+
+		for(int k = 0; k < 3; ++k)
+			normals.push_back(n[k] / length);
+	}
+
+	// Axis - average normal
+	float axis[3] = {0, 0, 0};
+
+	for(unsigned int i = 0; i < normals.size(); i += 3)
+		for(int k = 0; k < 3; ++k)
+			axis[k] += normals[i + k];
+
+	float length = sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+	if(length == 0)
+		return;
+
+	for(int k = 0; k < 3; ++k)
+		meshlet.coneAxis[k] = axis[k] / length;
+
+	// Cutoff - widest normal from the axis
+	float cutoff = 1;
+
+	for(unsigned int i = 0; i < normals.size(); i += 3)
+	{
+		float d = normals[i] * meshlet.coneAxis[0] + normals[i + 1] * meshlet.coneAxis[1] + normals[i + 2] * meshlet.coneAxis[2];
+
+		if(d < cutoff)
+			cutoff = d;
+	}
+
+	meshlet.coneCutoff = cutoff > 0 ? cutoff : -1;
+}
+
+// Getters
+const std::vector<DCMeshlet>& DCMeshletBuilder::getMeshlets() const
+{
+	return meshlets;
+}
+
+const std::vector<unsigned int>& DCMeshletBuilder::getVertices() const
+{
+	return vertices;
+}
+
+const std::vector<unsigned char>& DCMeshletBuilder::getTriangles() const
+{
+	return triangles;
+}
+
+const std::vector<unsigned int>& DCMeshletBuilder::getFaces() const
+{
+	return faces;
+}
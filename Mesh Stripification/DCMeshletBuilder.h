@@ -0,0 +1,84 @@
+// ----------------------------------------
+// Class:		DCEL Meshlet Builder
+// Description:	Cuts a stripified mesh into clusters of
+//				bounded vertex and triangle counts
+// ----------------------------------------
+
+#pragma once
+#ifndef DCMESHLETBUILDER
+#define DCMESHLETBUILDER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+#include "DCStripifier.h"
+
+// ----------------------------------------
+
+// Local indices are bytes
+#define DC_MESHLET_MAX_VERTICES 256
+
+// One cluster - ranges into the builder's flat arrays
+struct DCMeshlet
+{
+	unsigned int vertexOffset; // First entry in the meshlet vertex array
+	unsigned int vertexCount;
+	unsigned int triangleOffset; // First triangle in the meshlet triangle array
+	unsigned int triangleCount;
+
+	// Bounding sphere
+	float center[3];
+	float radius;
+
+	// Normal cone - unit average face normal, and the cosine of the widest
+	// face normal from it; -1 when the faces span more than a hemisphere
+	float coneAxis[3];
+	float coneCutoff;
+
+	DCMeshlet();
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Meshlets grow across half-edge neighbours, preferring the face adding
+// the fewest new vertices, then the face closest to the meshlet centre.
+// A meshlet is closed when no neighbour fits; the next one starts on its
+// frontier so consecutive meshlets stay spatially close.
+class DCMeshletBuilder
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	// Output
+	std::vector<DCMeshlet> meshlets;
+	std::vector<unsigned int> vertices; // Output vertex ids - per meshlet
+	std::vector<unsigned char> triangles; // Local vertex indices - 3 per triangle
+	std::vector<unsigned int> faces; // Face ids - in meshlet triangle order
+
+	// Methods ----------------------------
+	// Bounding sphere and normal cone
+	void setupBounds(DCMeshlet& meshlet, const DCStripifier& stripifier);
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCMeshletBuilder();
+	~DCMeshletBuilder();
+
+	// Builds meshlets over every visible face of a built stripifier
+	void build(const DCStripifier& stripifier, unsigned int maxVertices = 64, unsigned int maxTriangles = 124);
+
+	// Getters
+	const std::vector<DCMeshlet>& getMeshlets() const;
+	const std::vector<unsigned int>& getVertices() const;
+	const std::vector<unsigned char>& getTriangles() const;
+	const std::vector<unsigned int>& getFaces() const;
+};
+// ----------------------------------------
+
+#endif
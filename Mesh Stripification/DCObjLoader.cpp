@@ -0,0 +1,221 @@
+// ----------------------------------------
+// Class: DCEL OBJ Loader source
+// ----------------------------------------
+
+// Include header
+#include "DCObjLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "DCEL/Exception.h"
+
+// Load OBJ
+void DCObjLoader::load(const std::string& filename, DCMeshDef& meshDef)
+{
+	std::ifstream stream(filename.c_str());
+
+	if(!stream)
+		throw cpp::Exception("Can't open the file '" + filename + "'");
+
+	// Clear previous data
+	meshDef = DCMeshDef();
+
+	// File normals - indexed by vn
+	std::vector<float> fileNormals;
+	std::vector<unsigned int> faceNormals;
+	bool hasNormals = true;
+
+	// Material names - numbered from 1
+	std::vector<std::string> materialNames;
+	unsigned int material = 0;
+
+	std::string line;
+
+	while(std::getline(stream, line))
+	{
+		std::stringstream str(line);
+		std::string name;
+		str >> name;
+
+		if(name == "v")
+		{
+			float x = 0, y = 0, z = 0;
+			str >> x >> y >> z;
+
+			meshDef.positions.push_back(x);
+			meshDef.positions.push_back(y);
+			meshDef.positions.push_back(z);
+		}
+		else if(name == "vt")
+		{
+			float s = 0, t = 0;
+			str >> s >> t;
+
+			meshDef.texCoords.push_back(s);
+			meshDef.texCoords.push_back(t);
+		}
+		else if(name == "vn")
+		{
+			float x = 0, y = 0, z = 0;
+			str >> x >> y >> z;
+
+			fileNormals.push_back(x);
+			fileNormals.push_back(y);
+			fileNormals.push_back(z);
+		}
+		else if(name == "usemtl")
+		{
+			std::string materialName;
+			str >> materialName;
+
+			material = std::find(materialNames.begin(), materialNames.end(), materialName) - materialNames.begin() + 1;
+
+			if(material > materialNames.size())
+				materialNames.push_back(materialName);
+		}
+		else if(name == "f")
+		{
+			int numV = meshDef.positions.size() / 3;
+			int numT = meshDef.texCoords.size() / 2;
+			int numN = fileNormals.size() / 3;
+
+			// Read polygon corners
+			std::vector<int> v, t, n;
+			std::string corner;
+
+			while(str >> corner)
+			{
+				int cv, ct, cn;
+				parseCorner(corner, numV, numT, numN, cv, ct, cn);
+
+				if(cv < 0 || cv >= numV)
+					throw cpp::Exception("Invalid vertex index in '" + filename + "'");
+
+				v.push_back(cv);
+				t.push_back(ct);
+				n.push_back(cn);
+			}
+
+			// Triangle fan
+			for(unsigned int i = 2; i < v.size(); ++i)
+			{
+				unsigned int corners[3] = {0, i - 1, i};
+
+				meshDef.faceMaterials.push_back(material);
+
+				for(int j = 0; j < 3; ++j)
+				{
+					meshDef.faceVertices.push_back(v[corners[j]]);
+					meshDef.faceTexCoords.push_back(t[corners[j]] >= 0 && t[corners[j]] < numT ? t[corners[j]] : 0);
+
+					if(n[corners[j]] >= 0 && n[corners[j]] < numN)
+						faceNormals.push_back(n[corners[j]]);
+					else
+						hasNormals = false;
+				}
+			}
+		}
+	}
+
+	// Texture indices are only kept if the file has texture coordinates
+	if(meshDef.texCoords.empty())
+		meshDef.faceTexCoords.clear();
+
+	// Materials are only kept if the file names any
+	if(materialNames.empty())
+		meshDef.faceMaterials.clear();
+
+	// Average file normals per position
+	if(hasNormals && !fileNormals.empty())
+	{
+		meshDef.normals.assign(meshDef.positions.size(), 0.0f);
+
+		for(unsigned int i = 0; i < meshDef.faceVertices.size(); ++i)
+			for(int j = 0; j < 3; ++j)
+				meshDef.normals[meshDef.faceVertices[i] * 3 + j] += fileNormals[faceNormals[i] * 3 + j];
+
+		for(unsigned int i = 0; i < meshDef.normals.size(); i += 3)
+		{
+			float length = sqrt(meshDef.normals[i] * meshDef.normals[i] + meshDef.normals[i + 1] * meshDef.normals[i + 1] + meshDef.normals[i + 2] * meshDef.normals[i + 2]);
+
+			if(length > 0)
+				for(int j = 0; j < 3; ++j)
+					meshDef.normals[i + j] /= length;
+		}
+	}
+	else
+		buildFaceNormals(meshDef);
+}
+
+// Parse corner - OBJ indices are 1 based, negative values are relative to the end
+void DCObjLoader::parseCorner(const std::string& corner, int numV, int numT, int numN, int& v, int& t, int& n)
+{
+	int values[3] = {0, 0, 0};
+	int counts[3] = {numV, numT, numN};
+	unsigned int field = 0;
+	size_t start = 0;
+
+	while(field < 3 && start <= corner.size())
+	{
+		size_t end = corner.find('/', start);
+
+		if(end == std::string::npos)
+			end = corner.size();
+
+		if(end > start)
+			values[field] = atoi(corner.substr(start, end - start).c_str());
+
+		++field;
+		start = end + 1;
+	}
+
+	for(int i = 0; i < 3; ++i)
+	{
+		if(values[i] > 0)
+			values[i] -= 1;
+		else if(values[i] < 0)
+			values[i] += counts[i];
+		else
+			values[i] = -1; // Not present
+	}
+
+	v = values[0];
+	t = values[1];
+	n = values[2];
+}
+
+// Build normals - sum of adjacent face normals
+void DCObjLoader::buildFaceNormals(DCMeshDef& meshDef)
+{
+	meshDef.normals.assign(meshDef.positions.size(), 0.0f);
+
+	for(unsigned int i = 0; i < meshDef.faceVertices.size(); i += 3)
+	{
+		const float* p0 = &meshDef.positions[meshDef.faceVertices[i] * 3];
+		const float* p1 = &meshDef.positions[meshDef.faceVertices[i + 1] * 3];
+		const float* p2 = &meshDef.positions[meshDef.faceVertices[i + 2] * 3];
+
+		float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+		float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+		// Area weighted face normal
+		float normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+
+		for(int j = 0; j < 3; ++j)
+			for(int k = 0; k < 3; ++k)
+				meshDef.normals[meshDef.faceVertices[i + j] * 3 + k] += normal[k];
+	}
+
+	for(unsigned int i = 0; i < meshDef.normals.size(); i += 3)
+	{
+		float length = sqrt(meshDef.normals[i] * meshDef.normals[i] + meshDef.normals[i + 1] * meshDef.normals[i + 1] + meshDef.normals[i + 2] * meshDef.normals[i + 2]);
+
+		if(length > 0)
+			for(int j = 0; j < 3; ++j)
+				meshDef.normals[i + j] /= length;
+	}
+}
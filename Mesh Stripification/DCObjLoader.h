@@ -0,0 +1,50 @@
+// ----------------------------------------
+// Class:		DCEL OBJ Loader
+// Description:	Portable Wavefront OBJ reader - fills a
+//				DCMeshDef without CGImport3
+// ----------------------------------------
+
+#pragma once
+#ifndef DCOBJLOADER
+#define DCOBJLOADER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <string>
+
+#include "DCStripifier.h" // DCMeshDef
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Reads v, vt, vn, f and usemtl records. Polygons are split into
+// triangle fans and negative (relative) indices are resolved. Normals
+// are averaged per position, or built from face normals if the file
+// has none. Materials are numbered from 1 in order of first use, as
+// CGImport3 numbers them; faces before the first usemtl have material
+// 0. Throws cpp::Exception if the file cannot be read.
+class DCObjLoader
+{
+	// Reads faces with the same corner parser
+	friend class DCObjStream;
+
+// ----------------------------------------
+private:
+	// Methods ----------------------------
+	// Parses a face corner - "v", "v/t", "v//n" or "v/t/n"
+	static void parseCorner(const std::string& corner, int numV, int numT, int numN, int& v, int& t, int& n);
+
+	// Builds per-position normals from face normals
+	static void buildFaceNormals(DCMeshDef& meshDef);
+
+// ----------------------------------------
+public:
+
+	// Load an OBJ file into meshDef
+	static void load(const std::string& filename, DCMeshDef& meshDef);
+};
+// ----------------------------------------
+
+#endif
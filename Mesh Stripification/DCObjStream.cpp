@@ -0,0 +1,132 @@
+// ----------------------------------------
+// Class: DCEL OBJ Stream source
+// ----------------------------------------
+
+// Include header
+#include "DCObjStream.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "DCObjLoader.h"
+#include "DCEL/Exception.h"
+
+// Constructor
+DCObjStream::DCObjStream()
+{
+	numVertices = 0;
+	material = 0;
+	nextCorner = 0;
+}
+
+// Destructor
+DCObjStream::~DCObjStream()
+{
+}
+
+// Open
+void DCObjStream::open(const std::string& filename)
+{
+	this->filename = filename;
+
+	stream.close();
+	stream.clear();
+	stream.open(filename.c_str());
+
+	if(!stream)
+		throw cpp::Exception("Can't open the file '" + filename + "'");
+
+	numVertices = 0;
+	material = 0;
+	materialNames.clear();
+	polygon.clear();
+	nextCorner = 0;
+}
+
+// Rewind
+void DCObjStream::rewind()
+{
+	open(filename);
+}
+
+// Next vertex
+bool DCObjStream::nextVertex(float pos[3])
+{
+	while(std::getline(stream, line))
+	{
+		if(line.size() < 2 || line[0] != 'v' || (line[1] != ' ' && line[1] != '\t'))
+			continue;
+
+		std::stringstream str(line.substr(2));
+
+		pos[0] = pos[1] = pos[2] = 0;
+		str >> pos[0] >> pos[1] >> pos[2];
+
+		numVertices += 1;
+
+		return true;
+	}
+
+	return false;
+}
+
+// Next face - the rest of the last polygon's fan, then the next f record
+bool DCObjStream::nextFace(unsigned int v[3], unsigned int& material)
+{
+	while(nextCorner >= polygon.size())
+	{
+		if(!std::getline(stream, line))
+			return false;
+
+		std::stringstream str(line);
+		std::string name;
+		str >> name;
+
+		if(name == "v")
+			numVertices += 1;
+		else if(name == "usemtl")
+		{
+			std::string materialName;
+			str >> materialName;
+
+			this->material = std::find(materialNames.begin(), materialNames.end(), materialName) - materialNames.begin() + 1;
+
+			if(this->material > materialNames.size())
+				materialNames.push_back(materialName);
+		}
+		else if(name == "f")
+		{
+			polygon.clear();
+			nextCorner = 2;
+
+			std::string corner;
+
+			while(str >> corner)
+			{
+				int cv, ct, cn;
+				DCObjLoader::parseCorner(corner, numVertices, 0, 0, cv, ct, cn);
+
+				if(cv < 0 || cv >= (int)numVertices)
+					throw cpp::Exception("Invalid vertex index in '" + filename + "'");
+
+				polygon.push_back(cv);
+			}
+		}
+	}
+
+	// Triangle fan
+	v[0] = polygon[0];
+	v[1] = polygon[nextCorner - 1];
+	v[2] = polygon[nextCorner];
+	material = this->material;
+
+	nextCorner += 1;
+
+	return true;
+}
+
+// Getters
+unsigned int DCObjStream::getNumVertices() const
+{
+	return numVertices;
+}
@@ -0,0 +1,70 @@
+// ----------------------------------------
+// Class:		DCEL OBJ Stream
+// Description:	Sequential Wavefront OBJ reader - one vertex
+//				or face at a time, in constant memory
+// ----------------------------------------
+
+#pragma once
+#ifndef DCOBJSTREAM
+#define DCOBJSTREAM
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Reads the file in order without keeping it: vertices are returned by
+// nextVertex, faces by nextFace, each skipping the other's records, so a
+// file is read twice, once for each. Only v records are counted, to resolve
+// negative (relative) indices; polygons are split into triangle fans as
+// DCObjLoader splits them. Materials are numbered as DCObjLoader numbers
+// them. Throws cpp::Exception if the file cannot be read or a face has an
+// invalid index.
+class DCObjStream
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	std::string filename;
+	std::ifstream stream;
+	std::string line; // Last record read - reused
+
+	unsigned int numVertices; // v records read so far
+	unsigned int material; // Material of the last usemtl record
+	std::vector<std::string> materialNames;
+
+	// Fan of the last polygon read, returned one triangle at a time
+	std::vector<unsigned int> polygon;
+	unsigned int nextCorner;
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCObjStream();
+	~DCObjStream();
+
+	// Opens a file - reading starts at its first record
+	void open(const std::string& filename);
+
+	// Back to the first record
+	void rewind();
+
+	// Next vertex position - false once the file is read
+	bool nextVertex(float pos[3]);
+
+	// Next face - false once the file is read
+	bool nextFace(unsigned int v[3], unsigned int& material);
+
+	// Getters
+	unsigned int getNumVertices() const; // Vertices read so far
+};
+// ----------------------------------------
+
+#endif
@@ -0,0 +1,213 @@
+// ----------------------------------------
+// Class: DCEL Overdraw source
+// ----------------------------------------
+
+// Include header
+#include "DCOverdraw.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "DCIndexStream.h"
+
+// ----------------------------------------
+// Report
+// ----------------------------------------
+
+// Constructor
+DCOverdrawReport::DCOverdrawReport()
+{
+	views = 0;
+	resolution = 0;
+	covered = 0;
+	shaded = 0;
+	overdraw = 0;
+}
+
+// ----------------------------------------
+// Overdraw
+// ----------------------------------------
+
+// Fixed view directions - unnormalised
+static const float viewDirections[DC_OVERDRAW_VIEWS][3] =
+{
+	{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+	{1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1},
+	{-1, 1, 1}, {-1, 1, -1}, {-1, -1, 1}, {-1, -1, -1}
+};
+
+static void normalise(float* v)
+{
+	float length = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+	if(length > 0)
+		for(int k = 0; k < 3; ++k)
+			v[k] /= length;
+}
+
+static void cross(const float* a, const float* b, float* result)
+{
+	result[0] = a[1] * b[2] - a[2] * b[1];
+	result[1] = a[2] * b[0] - a[0] * b[2];
+	result[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static float dot(const float* a, const float* b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Measure - triangle list
+DCOverdrawReport DCOverdraw::measure(const std::vector<DCStripVertex>& vertices, const std::vector<unsigned int>& triangles, unsigned int resolution)
+{
+	DCOverdrawReport report;
+	report.views = DC_OVERDRAW_VIEWS;
+	report.resolution = resolution;
+
+	if(vertices.empty() || triangles.empty() || resolution == 0)
+		return report;
+
+	// Bounding sphere - box centre and furthest vertex
+	float minPos[3], maxPos[3], centre[3];
+
+	for(int k = 0; k < 3; ++k)
+		minPos[k] = maxPos[k] = vertices[0].pos[k];
+
+	for(unsigned int i = 0; i < vertices.size(); ++i)
+	{
+		for(int k = 0; k < 3; ++k)
+		{
+			if(vertices[i].pos[k] < minPos[k])
+				minPos[k] = vertices[i].pos[k];
+
+			if(vertices[i].pos[k] > maxPos[k])
+				maxPos[k] = vertices[i].pos[k];
+		}
+	}
+
+	for(int k = 0; k < 3; ++k)
+		centre[k] = (minPos[k] + maxPos[k]) / 2;
+
+	float radius = 0;
+
+	for(unsigned int i = 0; i < vertices.size(); ++i)
+	{
+		float d[3] = {vertices[i].pos[0] - centre[0], vertices[i].pos[1] - centre[1], vertices[i].pos[2] - centre[2]};
+		radius = std::max(radius, dot(d, d));
+	}
+
+	radius = sqrt(radius);
+
+	if(radius == 0)
+		return report;
+
+	std::vector<float> depth(resolution * resolution);
+	std::vector<float> screen(vertices.size() * 3);
+
+	for(unsigned int view = 0; view < DC_OVERDRAW_VIEWS; ++view)
+	{
+		// View basis - looking along forward
+		float forward[3] = {viewDirections[view][0], viewDirections[view][1], viewDirections[view][2]};
+		normalise(forward);
+
+		float up[3] = {0, 1, 0};
+
+		if(fabs(forward[1]) > 0.99f)
+		{
+			up[0] = 0;
+			up[1] = 0;
+			up[2] = 1;
+		}
+
+		float right[3], trueUp[3];
+		cross(up, forward, right);
+		normalise(right);
+		cross(forward, right, trueUp);
+
+		// Project to pixels - depth grows away from the viewer
+		for(unsigned int i = 0; i < vertices.size(); ++i)
+		{
+			float d[3] = {vertices[i].pos[0] - centre[0], vertices[i].pos[1] - centre[1], vertices[i].pos[2] - centre[2]};
+
+			screen[i * 3] = (dot(d, right) / radius * 0.5f + 0.5f) * resolution;
+			screen[i * 3 + 1] = (dot(d, trueUp) / radius * 0.5f + 0.5f) * resolution;
+			screen[i * 3 + 2] = dot(d, forward);
+		}
+
+		depth.assign(resolution * resolution, FLT_MAX);
+
+		for(unsigned int t = 0; t + 2 < triangles.size(); t += 3)
+		{
+			const float* a = &screen[triangles[t] * 3];
+			const float* b = &screen[triangles[t + 1] * 3];
+			const float* c = &screen[triangles[t + 2] * 3];
+
+			// Signed area - right handed, so front faces are clockwise on screen
+			float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+
+			if(area >= 0)
+				continue;
+
+			// Pixel bounds
+			int x0 = std::max(0, (int)floor(std::min(a[0], std::min(b[0], c[0]))));
+			int x1 = std::min((int)resolution - 1, (int)ceil(std::max(a[0], std::max(b[0], c[0]))));
+			int y0 = std::max(0, (int)floor(std::min(a[1], std::min(b[1], c[1]))));
+			int y1 = std::min((int)resolution - 1, (int)ceil(std::max(a[1], std::max(b[1], c[1]))));
+
+			for(int y = y0; y <= y1; ++y)
+			{
+				for(int x = x0; x <= x1; ++x)
+				{
+					float px = x + 0.5f;
+					float py = y + 0.5f;
+
+					// Barycentric weights - all negative inside a clockwise triangle
+					float wa = (c[0] - b[0]) * (py - b[1]) - (c[1] - b[1]) * (px - b[0]);
+					float wb = (a[0] - c[0]) * (py - c[1]) - (a[1] - c[1]) * (px - c[0]);
+					float wc = (b[0] - a[0]) * (py - a[1]) - (b[1] - a[1]) * (px - a[0]);
+
+					// Shared edges - pixels exactly on an edge belong to one side only
+					if(wa > 0 || wb > 0 || wc > 0)
+						continue;
+
+					if((wa == 0 && (c[1] - b[1] < 0 || (c[1] == b[1] && c[0] - b[0] > 0))) ||
+						(wb == 0 && (a[1] - c[1] < 0 || (a[1] == c[1] && a[0] - c[0] > 0))) ||
+						(wc == 0 && (b[1] - a[1] < 0 || (b[1] == a[1] && b[0] - a[0] > 0))))
+						continue;
+
+					float z = (wa * a[2] + wb * b[2] + wc * c[2]) / area;
+					float& stored = depth[y * resolution + x];
+
+					if(z < stored)
+					{
+						stored = z;
+						report.shaded += 1;
+					}
+				}
+			}
+		}
+
+		for(unsigned int i = 0; i < depth.size(); ++i)
+			if(depth[i] != FLT_MAX)
+				report.covered += 1;
+	}
+
+	if(report.covered)
+		report.overdraw = (float)report.shaded / report.covered;
+
+	return report;
+}
+
+// Measure - stripifier output
+DCOverdrawReport DCOverdraw::measure(const DCStripifier& stripifier, unsigned int resolution)
+{
+	std::vector<unsigned int> triangles;
+
+	if(stripifier.getSettings().stripify)
+		DCIndexStream::expandStrips(stripifier.getIndices(), stripifier.getDrawCounts(), DC_STRIP_CUT_32, triangles);
+	else
+		triangles = stripifier.getIndices();
+
+	return measure(stripifier.getVertices(), triangles, resolution);
+}
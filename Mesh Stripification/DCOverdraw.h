@@ -0,0 +1,57 @@
+// ----------------------------------------
+// Class:		DCEL Overdraw
+// Description:	Offline overdraw estimate - a small CPU
+//				depth-buffered rasteriser
+// ----------------------------------------
+
+#pragma once
+#ifndef DCOVERDRAW
+#define DCOVERDRAW
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+#include "DCStripifier.h"
+
+// ----------------------------------------
+
+// Fixed viewpoints - the six axes and the eight cube corners
+#define DC_OVERDRAW_VIEWS 14
+
+// Overdraw summed over every viewpoint
+struct DCOverdrawReport
+{
+	unsigned int views;
+	unsigned int resolution; // Square viewport side in pixels
+	unsigned long long covered; // Pixels covered by the mesh
+	unsigned long long shaded; // Fragments passing the depth test
+
+	float overdraw; // Shaded fragments per covered pixel
+
+	DCOverdrawReport();
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Triangles are drawn in submission order with orthographic projection
+// looking at the mesh centre, back faces culled (counter-clockwise is
+// front, as in OBJ) and a less-than depth test. Every fragment passing
+// the depth test would be shaded.
+class DCOverdraw
+{
+// ----------------------------------------
+public:
+
+	// Measure a triangle list over output vertices
+	static DCOverdrawReport measure(const std::vector<DCStripVertex>& vertices, const std::vector<unsigned int>& triangles, unsigned int resolution = 256);
+
+	// Measure the output of a stripifier
+	static DCOverdrawReport measure(const DCStripifier& stripifier, unsigned int resolution = 256);
+};
+// ----------------------------------------
+
+#endif
@@ -0,0 +1,363 @@
+// ----------------------------------------
+// Class: DCEL Stream Stripifier source
+// ----------------------------------------
+
+// Include header
+#include "DCStreamStripifier.h"
+
+#include <algorithm>
+
+#include "DCEL/Exception.h"
+
+// Ensure correct namespace use
+using namespace std;
+
+// Constructor
+DCStreamStripifier::DCStreamStripifier(std::ostream& out, unsigned int windowSize, const DCStripSettings& settings)
+	: settings(settings), out(&out)
+{
+	checkSettings(settings);
+
+	window.resize(windowSize > 0 ? windowSize : 1);
+	firstFace = 0;
+	numFaces = 0;
+	peakEdges = 0;
+	numIndices = 0;
+	lastIndex = 0;
+	degenerates = 0;
+
+	// Each window face waits for at most three edges
+	openEdges.reserve(window.size() * 3);
+}
+
+// Destructor
+DCStreamStripifier::~DCStreamStripifier()
+{
+}
+
+// Check settings - only maxLength and the output layout apply
+void DCStreamStripifier::checkSettings(const DCStripSettings& settings)
+{
+	if(settings.output == DC_OUTPUT_SEPARATE)
+		throw cpp::Exception("Streamed strips are one draw - restart or stitched output only");
+
+	if(settings.useTextures)
+		throw cpp::Exception("Streamed strips keep the input vertex ids - texture seams can't be split");
+
+	if(!settings.stripify || settings.strategy != DC_STRATEGY_GREEDY || settings.tunnelIterations || settings.threads > 1 ||
+		settings.seedRuns > 1 || settings.orderOverdraw)
+		throw cpp::Exception("Streamed strips are grown greedily, in one pass over the window");
+}
+
+// Is free
+bool DCStreamStripifier::isFree(unsigned int face) const
+{
+	return face != DC_NO_FACE && face >= firstFace && face < numFaces && getFace(face).free;
+}
+
+// Get face
+DCWindowFace& DCStreamStripifier::getFace(unsigned int face)
+{
+	return window[face % window.size()];
+}
+
+const DCWindowFace& DCStreamStripifier::getFace(unsigned int face) const
+{
+	return window[face % window.size()];
+}
+
+// Make edge key
+unsigned long long DCStreamStripifier::makeEdgeKey(unsigned int v1, unsigned int v2)
+{
+	if(v1 > v2)
+		return ((unsigned long long)v2 << 32) | v1;
+
+	return ((unsigned long long)v1 << 32) | v2;
+}
+
+// Add face - linked to the window faces waiting on its edges
+void DCStreamStripifier::addFace(const unsigned int v[3], unsigned int material)
+{
+	// Repeated vertex - draws nothing
+	if(v[0] == v[1] || v[1] == v[2] || v[2] == v[0])
+	{
+		degenerates += 1;
+		return;
+	}
+
+	if(numFaces - firstFace == window.size())
+		retireFace();
+
+	unsigned int id = numFaces++;
+	DCWindowFace& face = getFace(id);
+
+	face.material = material;
+	face.free = true;
+	face.degree = 0;
+
+	for(int i = 0; i < 3; ++i)
+	{
+		face.v[i] = v[i];
+		face.neighbours[i] = DC_NO_FACE;
+	}
+
+	for(unsigned int i = 0; i < 3; ++i)
+	{
+		unsigned long long key = makeEdgeKey(v[i], v[(i + 1) % 3]);
+		unordered_map<unsigned long long, unsigned int>::iterator it = openEdges.find(key);
+
+		if(it == openEdges.end())
+		{
+			openEdges[key] = id;
+			face.degree += 1;
+			continue;
+		}
+
+		unsigned int other = it->second;
+		DCWindowFace& neighbour = getFace(other);
+
+		// The same triangle twice, or across a material - the edge stays open for another face
+		unsigned int shared = 0;
+
+		for(int j = 0; j < 3; ++j)
+			if(neighbour.v[j] == v[0] || neighbour.v[j] == v[1] || neighbour.v[j] == v[2])
+				shared += 1;
+
+		if(shared == 3 || neighbour.material != material)
+			continue;
+
+		openEdges.erase(it);
+
+		// Slot of the shared edge in the neighbour
+		for(unsigned int j = 0; j < 3; ++j)
+			if(makeEdgeKey(neighbour.v[j], neighbour.v[(j + 1) % 3]) == key)
+				neighbour.neighbours[j] = id;
+
+		// The neighbour counted the edge while it waited
+		face.neighbours[i] = other;
+		face.degree += 1;
+	}
+
+	if(openEdges.size() > peakEdges)
+		peakEdges = openEdges.size();
+}
+
+// Finish
+void DCStreamStripifier::finish()
+{
+	while(firstFace < numFaces)
+		retireFace();
+
+	report.faces = numFaces;
+	report.indices = numIndices;
+	report.draws = numIndices ? 1 : 0;
+	report.submeshes = report.draws;
+
+	// Window ring and the edge map at its largest
+	report.sampleMemory("window", window.capacity() * sizeof(DCWindowFace));
+	report.sampleMemory("openEdges", openEdges.bucket_count() * sizeof(void*) +
+		(unsigned long long)peakEdges * (sizeof(pair<const unsigned long long, unsigned int>) + sizeof(void*)));
+	report.sampleMemory("strip", strip.capacity() * sizeof(unsigned int) + stripIndices.capacity() * sizeof(unsigned int));
+}
+
+// Retire face
+void DCStreamStripifier::retireFace()
+{
+	if(getFace(firstFace).free)
+		growStrip(firstFace);
+
+	firstFace += 1;
+}
+
+// Grow strip - forward from the face, then back from it, so a strip started
+// at the window's oldest face can still run over the faces before it
+void DCStreamStripifier::growStrip(unsigned int face)
+{
+	strip.clear();
+	strip.push_back(face);
+	takeFace(face);
+
+	while(strip.size() < settings.maxLength && (face = selectNeighbour(face)) != DC_NO_FACE)
+	{
+		strip.push_back(face);
+		takeFace(face);
+	}
+
+	unsigned int forward = strip.size();
+	face = strip[0];
+
+	while(strip.size() < settings.maxLength && (face = selectNeighbour(face)) != DC_NO_FACE)
+	{
+		strip.push_back(face);
+		takeFace(face);
+	}
+
+	// Faces grown back lead the strip, nearest the first face last
+	std::reverse(strip.begin() + forward, strip.end());
+	std::rotate(strip.begin(), strip.begin() + forward, strip.end());
+
+	writeStrip();
+}
+
+// Select neighbour - lowest degree; a neighbour with no other free neighbours is taken at once
+unsigned int DCStreamStripifier::selectNeighbour(unsigned int face) const
+{
+	unsigned int selected = DC_NO_FACE;
+
+	for(int i = 0; i < 3; ++i)
+	{
+		unsigned int neighbour = getFace(face).neighbours[i];
+
+		if(!isFree(neighbour))
+			continue;
+
+		if(selected == DC_NO_FACE || getFace(neighbour).degree < getFace(selected).degree)
+			selected = neighbour;
+
+		if(getFace(selected).degree == 0)
+			break;
+	}
+
+	return selected;
+}
+
+// Take face
+void DCStreamStripifier::takeFace(unsigned int face)
+{
+	DCWindowFace& taken = getFace(face);
+	taken.free = false;
+
+	for(int i = 0; i < 3; ++i)
+	{
+		if(isFree(taken.neighbours[i]))
+			getFace(taken.neighbours[i]).degree -= 1;
+
+		// A face arriving later can no longer join a strip here
+		if(taken.neighbours[i] == DC_NO_FACE)
+		{
+			unordered_map<unsigned long long, unsigned int>::iterator it = openEdges.find(makeEdgeKey(taken.v[i], taken.v[(i + 1) % 3]));
+
+			if(it != openEdges.end() && it->second == face)
+				openEdges.erase(it);
+		}
+	}
+}
+
+// Emit strip - as DCStripifier::emitStrip, from the vertices the faces share
+unsigned int DCStreamStripifier::emitStrip()
+{
+	unsigned int swapCount = 0;
+
+	stripIndices.clear();
+
+	const unsigned int* v = getFace(strip[0]).v;
+
+	// Check for single triangle strip
+	if(strip.size() == 1)
+	{
+		for(int k = 0; k < 3; ++k)
+			stripIndices.push_back(v[k]);
+
+		return 0;
+	}
+
+	// The standalone is the vertex off the edge to the next face
+	const unsigned int* next = getFace(strip[1]).v;
+
+	for(unsigned int j = 0; j < 3; ++j)
+	{
+		if(v[j] != next[0] && v[j] != next[1] && v[j] != next[2])
+		{
+			stripIndices.push_back(v[j]);
+			stripIndices.push_back(v[(j + 1) % 3]);
+			stripIndices.push_back(v[(j + 2) % 3]);
+		}
+	}
+
+	for(unsigned int i = 1; i < strip.size(); ++i)
+	{
+		const unsigned int* prev = getFace(strip[i - 1]).v;
+		v = getFace(strip[i]).v;
+
+		// Vertex of the face off the edge to the previous face
+		unsigned int other = 0;
+
+		for(int j = 0; j < 3; ++j)
+			if(v[j] != prev[0] && v[j] != prev[1] && v[j] != prev[2])
+				other = v[j];
+
+		if(i == strip.size() - 1)
+		{
+			stripIndices.push_back(other);
+			break;
+		}
+
+		// Common vertex of the previous and next faces
+		next = getFace(strip[i + 1]).v;
+		unsigned int common = 0;
+
+		for(int j = 0; j < 3; ++j)
+			if((v[j] == prev[0] || v[j] == prev[1] || v[j] == prev[2]) && (v[j] == next[0] || v[j] == next[1] || v[j] == next[2]))
+				common = v[j];
+
+		// If the common vertex is not the 'tail' of the strip, swap
+		if(stripIndices.back() != common)
+		{
+			stripIndices.push_back(common);
+			++swapCount;
+		}
+
+		stripIndices.push_back(other);
+	}
+
+	return swapCount;
+}
+
+// Write strip - joined to the strips before it in one draw
+void DCStreamStripifier::writeStrip()
+{
+	report.swaps += emitStrip();
+	report.strips += 1;
+	report.addStripLength(strip.size());
+
+	unsigned int first = stripIndices[0];
+	unsigned int join[3];
+	unsigned int numJoin = 0;
+
+	if(numIndices && settings.output == DC_OUTPUT_STITCHED)
+	{
+		join[numJoin++] = lastIndex;
+		join[numJoin++] = first;
+
+		// Strips must start on an even index of the draw to keep their winding
+		if((numIndices + numJoin) % 2)
+			join[numJoin++] = first;
+	}
+	else if(numIndices)
+		join[numJoin++] = DC_STRIP_CUT_32;
+
+	if(numJoin)
+		out->write((const char*)join, numJoin * sizeof(unsigned int));
+
+	out->write((const char*)&stripIndices[0], stripIndices.size() * sizeof(unsigned int));
+
+	numIndices += numJoin + stripIndices.size();
+	lastIndex = stripIndices.back();
+	report.joinIndices += numJoin;
+}
+
+// Getters
+unsigned int DCStreamStripifier::getNumIndices() const
+{
+	return numIndices;
+}
+
+unsigned int DCStreamStripifier::getNumDegenerates() const
+{
+	return degenerates;
+}
+
+const DCStripReport& DCStreamStripifier::getReport() const
+{
+	return report;
+}
@@ -0,0 +1,133 @@
+// ----------------------------------------
+// Class:		DCEL Stream Stripifier
+// Description:	Out-of-core stripification - faces arrive one
+//				at a time and finished strips are written as
+//				they leave a bounded window
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTREAMSTRIPIFIER
+#define DCSTREAMSTRIPIFIER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "DCStripifier.h" // DCStripSettings, DCStripReport
+
+// ----------------------------------------
+
+// Face held in the window
+struct DCWindowFace
+{
+	unsigned int v[3];
+	unsigned int neighbours[3]; // Face ids across each edge v[i], v[i + 1] - DC_NO_FACE until one arrives
+	unsigned int material;
+	bool free;
+	int degree; // Free neighbours and edges still waiting for one
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// The window is a ring of the last windowSize faces added. Edges of window
+// faces still waiting for their second face are kept in a hash map, so a
+// new face is linked to its neighbours as it arrives; edges are dropped
+// once their face is stripped. When the window is full the oldest face
+// leaves it: if it is still free, a strip is grown from it over window
+// faces, lowest degree neighbour first, forward and then back from it, and
+// written to the output at once.
+// Memory is bounded by the window - the mesh is never held. A waiting edge
+// counts towards a face's degree, so strips keep to the oldest faces rather
+// than running into the newest, whose neighbours have not arrived yet.
+//
+// Faces must arrive in a spatially coherent order, as scans and most
+// exported meshes are stored; a neighbour arriving after its face left the
+// window is not linked, so strips end there. Indices are the input vertex
+// ids - texture seams are not duplicated - and strips never cross a
+// material, but are not grouped by it. The output is one draw: strips are
+// split by the strip cut index, or stitched with degenerate triangles when
+// settings.output is DC_OUTPUT_STITCHED; 32-bit indices are written.
+// Only maxLength and the output layout apply: separate output, texture
+// seams or any other strip growth throw cpp::Exception rather than being
+// ignored.
+class DCStreamStripifier
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	DCStripSettings settings;
+	std::ostream* out;
+
+	// Window - face id modulo the window size
+	std::vector<DCWindowFace> window;
+	unsigned int firstFace; // Oldest face in the window
+	unsigned int numFaces; // Faces added
+
+	// Edges waiting for their second face - ordered vertex pair to face id
+	std::unordered_map<unsigned long long, unsigned int> openEdges;
+	unsigned int peakEdges;
+
+	// Strip being written - reused
+	std::vector<unsigned int> strip;
+	std::vector<unsigned int> stripIndices;
+
+	// Output
+	unsigned int numIndices; // Written
+	unsigned int lastIndex;
+	unsigned int degenerates; // Degenerate faces skipped
+	DCStripReport report;
+
+	// Methods ----------------------------
+	// Face in the window, not yet stripped
+	bool isFree(unsigned int face) const;
+
+	// Window entry of a face
+	DCWindowFace& getFace(unsigned int face);
+	const DCWindowFace& getFace(unsigned int face) const;
+
+	// Edge key - the vertex pair in either order
+	static unsigned long long makeEdgeKey(unsigned int v1, unsigned int v2);
+
+	// Oldest face leaves the window - stripped first if still free
+	void retireFace();
+
+	// Strip growth - from a free face over free window neighbours, both ways
+	void growStrip(unsigned int face);
+	unsigned int selectNeighbour(unsigned int face) const; // Free neighbour to grow into, DC_NO_FACE if none
+
+	// Taken - neighbours lose a free neighbour, open edges are dropped
+	void takeFace(unsigned int face);
+
+	// Strip indices, then written with the join of the output layout
+	unsigned int emitStrip();
+	void writeStrip();
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCStreamStripifier(std::ostream& out, unsigned int windowSize, const DCStripSettings& settings);
+	~DCStreamStripifier();
+
+	// Throws cpp::Exception for settings the stream can't honour
+	static void checkSettings(const DCStripSettings& settings);
+
+	// Adds a face - strips leaving the window are written
+	void addFace(const unsigned int v[3], unsigned int material = 0);
+
+	// Strips the faces left in the window - the output is complete
+	void finish();
+
+	// Getters
+	unsigned int getNumIndices() const; // Written so far
+	unsigned int getNumDegenerates() const; // Faces skipped for a repeated vertex
+	const DCStripReport& getReport() const; // Output counts and the window's memory - complete after finish
+};
+// ----------------------------------------
+
+#endif
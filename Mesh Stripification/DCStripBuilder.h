@@ -0,0 +1,401 @@
+// ----------------------------------------
+// Class:		DCEL Strip Builder
+// Description:	Strip growth as a template over policies -
+//				seed selection, neighbour scoring, seam
+//				predicate and termination
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTRIPBUILDER
+#define DCSTRIPBUILDER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+#include "DCStripifier.h"
+
+// ----------------------------------------
+
+// Tables a build reads - filled by the stripifier. Free and degree are
+// read from the build's own face states
+struct DCStripContext
+{
+	const DCMesh* model;
+	const DCStripSettings* settings;
+	const std::vector<DCFaceAdjacency>* adjacency;
+	const std::vector<unsigned int>* faceRegions; // Empty for a serial build
+	const std::vector<unsigned int>* vertexFaceStart; // Faces around each output vertex - cached seeds only
+	const std::vector<unsigned int>* vertexFaces;
+
+	const FaceData& getFace(unsigned int face) const
+	{
+		return model->getFace(face)->getData();
+	}
+
+	// Visible faces of the build's own region
+	bool isInRegion(const DCStripBuild& build, unsigned int face) const
+	{
+		if(getFace(face).hidden)
+			return false;
+
+		return build.region == DC_NO_REGION || (*faceRegions)[face] == build.region;
+	}
+
+	// Vertices of the face in the build's simulated cache
+	unsigned int countCached(const DCStripBuild& build, unsigned int face) const
+	{
+		unsigned int count = 0;
+
+		for(int i = 0; i < 3; ++i)
+			if(build.cache.contains(getFace(face).v[i]))
+				count += 1;
+
+		return count;
+	}
+};
+
+// ----------------------------------------
+// Seam predicates - edges a strip never crosses
+// ----------------------------------------
+
+// Texture and material seams marked by the adjacency setup
+struct DCAdjacencySeams
+{
+	static bool isSeam(const DCStripContext& context, unsigned int face, unsigned int slot)
+	{
+		return ((*context.adjacency)[face].seams & (1 << slot)) != 0;
+	}
+};
+
+// Open edge - the neighbour across the slot is free, in the build's region and not across a seam
+template <class Seam>
+struct DCOpenEdge
+{
+	static bool isOpen(const DCStripContext& context, const DCStripBuild& build, unsigned int face, unsigned int slot)
+	{
+		unsigned int neighbour = (*context.adjacency)[face].neighbours[slot];
+
+		if(neighbour == DC_NO_FACE || !context.isInRegion(build, neighbour) || !build.faces[neighbour].free)
+			return false;
+
+		return !Seam::isSeam(context, face, slot);
+	}
+};
+
+// ----------------------------------------
+// Seed selection - first face of each strip, DC_NO_FACE when none is free
+// ----------------------------------------
+
+// Lowest degree, then lowest id
+struct DCLowestDegreeSeed
+{
+	static unsigned int select(const DCStripContext&, DCStripBuild& build)
+	{
+		return build.freeFaces.getMin();
+	}
+};
+
+// Free face with the most cached vertices, then lowest degree, then lowest id -
+// starts next to the last strip. Reads the cache DCCachedNeighbour fills
+struct DCCachedSeed
+{
+	static unsigned int select(const DCStripContext& context, DCStripBuild& build)
+	{
+		unsigned int selected = DC_NO_FACE;
+		unsigned int selectedCached = 0;
+
+		const std::vector<unsigned int>& entries = build.cache.getEntries();
+		const std::vector<unsigned int>& vertexFaceStart = *context.vertexFaceStart;
+		const std::vector<unsigned int>& vertexFaces = *context.vertexFaces;
+
+		for(unsigned int i = 0; i < entries.size(); ++i)
+		{
+			for(unsigned int j = vertexFaceStart[entries[i]]; j < vertexFaceStart[entries[i] + 1]; ++j)
+			{
+				unsigned int face = vertexFaces[j];
+
+				if(!context.isInRegion(build, face) || !build.faces[face].free)
+					continue;
+
+				unsigned int cached = context.countCached(build, face);
+
+				if(selected == DC_NO_FACE || cached > selectedCached ||
+					(cached == selectedCached && build.faces[face].degree < build.faces[selected].degree) ||
+					(cached == selectedCached && build.faces[face].degree == build.faces[selected].degree && face < selected))
+				{
+					selected = face;
+					selectedCached = cached;
+				}
+			}
+		}
+
+		// Nothing cached is free - lowest degree
+		if(selected == DC_NO_FACE)
+			return build.freeFaces.getMin();
+
+		return selected;
+	}
+};
+
+// ----------------------------------------
+// Neighbour scoring - next face of a strip, DC_NO_FACE to end it. begin
+// runs before a build's strips and take on every face added to a strip
+// ----------------------------------------
+
+// Lowest degree - a neighbour with no other free neighbours is taken at once
+struct DCDegreeNeighbour
+{
+	static void begin(const DCStripContext&, DCStripBuild&)
+	{
+	}
+
+	static void take(const DCStripContext&, DCStripBuild&, unsigned int)
+	{
+	}
+
+	template <class Seam>
+	static unsigned int select(const DCStripContext& context, DCStripBuild& build, unsigned int face)
+	{
+		unsigned int selected = DC_NO_FACE;
+
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			if(!DCOpenEdge<Seam>::isOpen(context, build, face, i))
+				continue;
+
+			unsigned int neighbour = (*context.adjacency)[face].neighbours[i];
+
+			if(build.faces[neighbour].degree == 0)
+				return neighbour;
+
+			if(selected == DC_NO_FACE || build.faces[neighbour].degree < build.faces[selected].degree)
+				selected = neighbour;
+		}
+
+		return selected;
+	}
+};
+
+// Most cached vertices, then lowest degree - taken faces are transformed in the simulated cache
+struct DCCachedNeighbour
+{
+	static void begin(const DCStripContext& context, DCStripBuild& build)
+	{
+		build.cache = DCVertexCache(context.settings->cacheType, context.settings->cacheSize);
+	}
+
+	static void take(const DCStripContext& context, DCStripBuild& build, unsigned int face)
+	{
+		for(int i = 0; i < 3; ++i)
+			build.cache.access(context.getFace(face).v[i]);
+	}
+
+	template <class Seam>
+	static unsigned int select(const DCStripContext& context, DCStripBuild& build, unsigned int face)
+	{
+		unsigned int selected = DC_NO_FACE;
+		unsigned int selectedCached = 0;
+
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			if(!DCOpenEdge<Seam>::isOpen(context, build, face, i))
+				continue;
+
+			unsigned int neighbour = (*context.adjacency)[face].neighbours[i];
+			unsigned int cached = context.countCached(build, neighbour);
+
+			if(selected == DC_NO_FACE || cached > selectedCached ||
+				(cached == selectedCached && build.faces[neighbour].degree < build.faces[selected].degree))
+			{
+				selected = neighbour;
+				selectedCached = cached;
+			}
+		}
+
+		return selected;
+	}
+};
+
+// Neighbour reaching the longest strip over the next lookAhead faces, then
+// the lowest degree; a neighbour with no other free neighbours is taken at
+// once. Paths stop at maxLength. Depth 0 is the greedy strategy. Counting
+// the faces a path isolates, between length and degree, lost to greedy on
+// the chair models at every depth and is left out
+struct DCLookAheadNeighbour
+{
+	static void begin(const DCStripContext& context, DCStripBuild& build)
+	{
+		if(build.lookTaken.size() != context.model->getNumFaces())
+			build.lookTaken.assign(context.model->getNumFaces(), false);
+	}
+
+	static void take(const DCStripContext&, DCStripBuild&, unsigned int)
+	{
+	}
+
+	template <class Seam>
+	static unsigned int select(const DCStripContext& context, DCStripBuild& build, unsigned int face)
+	{
+		// Faces the strip can still take
+		unsigned int depth = context.settings->lookAhead;
+		unsigned int room = context.settings->maxLength - build.strips.getOpenLength();
+
+		if(room < depth)
+			depth = room;
+
+		if(depth == 0)
+			return DCDegreeNeighbour::template select<Seam>(context, build, face);
+
+		unsigned int selected = DC_NO_FACE;
+		unsigned int selectedLength = 0;
+
+		// The current face is already taken
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			if(!isCandidate<Seam>(context, build, face, i))
+				continue;
+
+			unsigned int neighbour = (*context.adjacency)[face].neighbours[i];
+
+			if(build.faces[neighbour].degree == 0)
+				return neighbour;
+
+			unsigned int length = scorePath<Seam>(context, build, neighbour, depth);
+
+			if(selected == DC_NO_FACE || length > selectedLength ||
+				(length == selectedLength && build.faces[neighbour].degree < build.faces[selected].degree))
+			{
+				selected = neighbour;
+				selectedLength = length;
+			}
+		}
+
+		return selected;
+	}
+
+	// Score path - faces of the longest strip from the face over at most depth faces; a
+	// dead end scores 1, below any path that goes on
+	template <class Seam>
+	static unsigned int scorePath(const DCStripContext& context, DCStripBuild& build, unsigned int face, unsigned int depth)
+	{
+		unsigned int best = 0;
+
+		if(depth > 1)
+		{
+			build.lookTaken[face] = true;
+
+			for(unsigned int i = 0; i < 3 && best < depth - 1; ++i)
+			{
+				if(!isCandidate<Seam>(context, build, face, i))
+					continue;
+
+				unsigned int next = scorePath<Seam>(context, build, (*context.adjacency)[face].neighbours[i], depth - 1);
+
+				if(next > best)
+					best = next;
+			}
+
+			build.lookTaken[face] = false;
+		}
+
+		return best + 1;
+	}
+
+	// Is candidate - an open edge to a face not taken by the scored path
+	template <class Seam>
+	static bool isCandidate(const DCStripContext& context, const DCStripBuild& build, unsigned int face, unsigned int slot)
+	{
+		if(!DCOpenEdge<Seam>::isOpen(context, build, face, slot))
+			return false;
+
+		return !build.lookTaken[(*context.adjacency)[face].neighbours[slot]];
+	}
+};
+
+// ----------------------------------------
+// Termination - ends a strip before the next face is chosen; the strip
+// is the list's open strip
+// ----------------------------------------
+
+// maxLength faces
+struct DCMaxLengthTermination
+{
+	static bool isDone(const DCStripContext& context, const DCStripList& strips)
+	{
+		return strips.getOpenLength() >= context.settings->maxLength;
+	}
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Each instantiation compiles to its own growth loop with every policy call
+// resolved statically; the stripifier picks one per build from its strategy
+template <class Seed, class Neighbour, class Seam, class Termination>
+class DCStripBuilder
+{
+// ----------------------------------------
+private:
+	// Create strip - from the seed until the neighbour policy finds no face or the strip terminates
+	static void createStrip(const DCStripContext& context, DCStripBuild& build, unsigned int face)
+	{
+		const std::vector<DCFaceAdjacency>& adjacency = *context.adjacency;
+
+		while(true)
+		{
+			build.strips.addFace(face);
+
+			// Taken - neighbours lose a free neighbour
+			build.faces[face].free = 0;
+			build.freeFaces.remove(face);
+
+			Neighbour::take(context, build, face);
+
+			// Faces of other regions belong to other threads
+			for(int i = 0; i < 3; ++i)
+			{
+				unsigned int neighbour = adjacency[face].neighbours[i];
+
+				if(neighbour != DC_NO_FACE && context.isInRegion(build, neighbour))
+				{
+					build.faces[neighbour].degree -= 1;
+					build.freeFaces.update(neighbour, build.faces[neighbour].degree);
+				}
+			}
+
+			if(Termination::isDone(context, build.strips) || build.faces[face].degree == 0)
+				break;
+
+			face = Neighbour::template select<Seam>(context, build, face);
+
+			if(face == DC_NO_FACE)
+				break;
+		}
+
+		build.strips.endStrip();
+	}
+
+// ----------------------------------------
+public:
+
+	// Strips from the build's queued faces until none are left
+	static void stripFreeFaces(const DCStripContext& context, DCStripBuild& build)
+	{
+		Neighbour::begin(context, build);
+
+		unsigned int face = Seed::select(context, build);
+
+		while(face != DC_NO_FACE)
+		{
+			createStrip(context, build, face);
+
+			face = Seed::select(context, build);
+		}
+	}
+};
+// ----------------------------------------
+
+#endif
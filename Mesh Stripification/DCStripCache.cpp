@@ -0,0 +1,245 @@
+// ----------------------------------------
+// Class: DCEL Strip Cache source
+// ----------------------------------------
+
+// Include header
+#include "DCStripCache.h"
+
+#include <cstdio>
+
+// Entry file tag - bumped when the layout or the stripifier output changes
+static const char dccTag[4] = {'D', 'C', 'C', '4'};
+
+// FNV-1a 64-bit
+#define DC_FNV_OFFSET 0xcbf29ce484222325ULL
+#define DC_FNV_PRIME 0x100000001b3ULL
+
+// Hash bytes
+unsigned long long DCStripCache::hashBytes(const void* data, unsigned int size, unsigned long long hash)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+
+	for(unsigned int i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= DC_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+unsigned long long DCStripCache::hashUInt(unsigned int value, unsigned long long hash)
+{
+	return hashBytes(&value, sizeof(unsigned int), hash);
+}
+
+// Make key - file bytes, then the tag and each setting that changes the output
+unsigned long long DCStripCache::makeKey(const std::vector<char>& modelBytes, const DCStripSettings& settings)
+{
+	unsigned long long hash = DC_FNV_OFFSET;
+
+	if(!modelBytes.empty())
+		hash = hashBytes(&modelBytes[0], modelBytes.size(), hash);
+
+	hash = hashBytes(dccTag, 4, hash);
+
+	hash = hashUInt(settings.stripify, hash);
+	hash = hashUInt(settings.output, hash);
+	hash = hashUInt(settings.useTextures, hash);
+	hash = hashUInt(settings.maxLength, hash);
+	hash = hashUInt(settings.reorderVertices, hash);
+
+	hash = hashUInt(settings.strategy, hash);
+	hash = hashUInt(settings.cacheType, hash);
+	hash = hashUInt(settings.cacheSize, hash);
+	hash = hashUInt(settings.lookAhead, hash);
+
+	hash = hashUInt(settings.tunnelIterations, hash);
+	hash = hashUInt(settings.tunnelDepth, hash);
+
+	// Regions change the strips
+	hash = hashUInt(settings.threads > 1 ? settings.threads : 1, hash);
+
+	// Seed runs change the strips - single runs keep their keys
+	if(settings.seedRuns > 1)
+	{
+		hash = hashUInt(settings.seedRuns, hash);
+		hash = hashUInt(settings.seedScore, hash);
+	}
+
+	hash = hashUInt(settings.orderOverdraw, hash);
+	hash = hashBytes(&settings.overdrawThreshold, sizeof(float), hash);
+
+	return hash;
+}
+
+// Get key name
+std::string DCStripCache::getKeyName(unsigned long long key)
+{
+	char name[17];
+	sprintf(name, "%08x%08x", (unsigned int)(key >> 32), (unsigned int)key);
+
+	return name;
+}
+
+// Get filename
+std::string DCStripCache::getFilename(unsigned long long key)
+{
+	return getKeyName(key) + DC_CACHE_EXTENSION;
+}
+
+// Read an unsigned int
+static bool readUInt(std::istream& in, unsigned int& value)
+{
+	in.read((char*)&value, sizeof(unsigned int));
+	return in.good();
+}
+
+// Bytes left in a stream, false if it can't seek
+static bool getBytesLeft(std::istream& in, unsigned long long& bytes)
+{
+	std::streampos position = in.tellg();
+
+	if(position < 0 || !in.seekg(0, std::ios::end))
+		return false;
+
+	std::streampos end = in.tellg();
+	in.seekg(position);
+
+	if(end < position || !in.good())
+		return false;
+
+	bytes = (unsigned long long)(end - position);
+	return true;
+}
+
+// Load - tag, key, textured, array sizes, then the arrays and tables
+bool DCStripCache::load(std::istream& in, unsigned long long key, DCStripifier& stripifier)
+{
+	char tag[4];
+	unsigned long long entryKey = 0;
+	unsigned int textured, numVertices, numIndices, numDraws, numSubmeshes, numSpans;
+
+	in.read(tag, 4);
+	in.read((char*)&entryKey, sizeof(unsigned long long));
+
+	if(!in.good() || tag[0] != dccTag[0] || tag[1] != dccTag[1] || tag[2] != dccTag[2] || tag[3] != dccTag[3] || entryKey != key)
+		return false;
+
+	if(!readUInt(in, textured) || !readUInt(in, numVertices) || !readUInt(in, numIndices) || !readUInt(in, numDraws) || !readUInt(in, numSubmeshes) || !readUInt(in, numSpans))
+		return false;
+
+	// Counts from a damaged entry must not size the arrays past the file
+	unsigned long long bytesLeft = 0;
+	const unsigned long long bytesNeeded = sizeof(DCStripVertex) * (unsigned long long)numVertices +
+		sizeof(unsigned int) * ((unsigned long long)numIndices + numDraws + 5ULL * numSubmeshes + 3ULL * numSpans);
+
+	if(!getBytesLeft(in, bytesLeft) || bytesNeeded > bytesLeft)
+		return false;
+
+	std::vector<DCStripVertex> vertices(numVertices);
+	std::vector<unsigned int> indices(numIndices);
+	std::vector<unsigned int> drawCounts(numDraws);
+	std::vector<DCSubmesh> submeshes(numSubmeshes);
+	std::vector<DCStripSpan> spans(numSpans);
+
+	if(numVertices)
+		in.read((char*)&vertices[0], sizeof(DCStripVertex) * numVertices);
+
+	if(numIndices)
+		in.read((char*)&indices[0], sizeof(unsigned int) * numIndices);
+
+	if(numDraws)
+		in.read((char*)&drawCounts[0], sizeof(unsigned int) * numDraws);
+
+	for(unsigned int i = 0; i < numSubmeshes; ++i)
+		if(!readUInt(in, submeshes[i].material) || !readUInt(in, submeshes[i].range.start) || !readUInt(in, submeshes[i].range.count) ||
+			!readUInt(in, submeshes[i].firstDraw) || !readUInt(in, submeshes[i].numDraws))
+			return false;
+
+	for(unsigned int i = 0; i < numSpans; ++i)
+		if(!readUInt(in, spans[i].numFaces) || !readUInt(in, spans[i].range.start) || !readUInt(in, spans[i].range.count))
+			return false;
+
+	if(!in.good())
+		return false;
+
+	// A damaged entry must not reach the index buffer
+	unsigned int drawn = 0;
+
+	for(unsigned int i = 0; i < numDraws; ++i)
+		drawn += drawCounts[i];
+
+	if(drawn != numIndices)
+		return false;
+
+	for(unsigned int i = 0; i < numIndices; ++i)
+		if(indices[i] >= numVertices && indices[i] != DC_STRIP_CUT_32)
+			return false;
+
+	for(unsigned int i = 0; i < numSubmeshes; ++i)
+		if(submeshes[i].range.start > numIndices || submeshes[i].range.count > numIndices - submeshes[i].range.start ||
+			submeshes[i].firstDraw > numDraws || submeshes[i].numDraws > numDraws - submeshes[i].firstDraw)
+			return false;
+
+	for(unsigned int i = 0; i < numSpans; ++i)
+		if(spans[i].range.start > numIndices || spans[i].range.count > numIndices - spans[i].range.start)
+			return false;
+
+	stripifier.restoreOutput(vertices, indices, drawCounts, submeshes, spans, textured != 0);
+
+	return true;
+}
+
+// Write an unsigned int
+static void writeUInt(std::ostream& out, unsigned int value)
+{
+	out.write((const char*)&value, sizeof(unsigned int));
+}
+
+// Save
+bool DCStripCache::save(std::ostream& out, unsigned long long key, const DCStripifier& stripifier)
+{
+	const std::vector<DCStripVertex>& vertices = stripifier.getVertices();
+	const std::vector<unsigned int>& indices = stripifier.getIndices();
+	const std::vector<unsigned int>& drawCounts = stripifier.getDrawCounts();
+	const std::vector<DCSubmesh>& submeshes = stripifier.getSubmeshes();
+	const std::vector<DCStripSpan>& spans = stripifier.getStripSpans();
+
+	out.write(dccTag, 4);
+	out.write((const char*)&key, sizeof(unsigned long long));
+
+	writeUInt(out, stripifier.isTextured());
+	writeUInt(out, vertices.size());
+	writeUInt(out, indices.size());
+	writeUInt(out, drawCounts.size());
+	writeUInt(out, submeshes.size());
+	writeUInt(out, spans.size());
+
+	if(!vertices.empty())
+		out.write((const char*)&vertices[0], sizeof(DCStripVertex) * vertices.size());
+
+	if(!indices.empty())
+		out.write((const char*)&indices[0], sizeof(unsigned int) * indices.size());
+
+	if(!drawCounts.empty())
+		out.write((const char*)&drawCounts[0], sizeof(unsigned int) * drawCounts.size());
+
+	for(unsigned int i = 0; i < submeshes.size(); ++i)
+	{
+		writeUInt(out, submeshes[i].material);
+		writeUInt(out, submeshes[i].range.start);
+		writeUInt(out, submeshes[i].range.count);
+		writeUInt(out, submeshes[i].firstDraw);
+		writeUInt(out, submeshes[i].numDraws);
+	}
+
+	for(unsigned int i = 0; i < spans.size(); ++i)
+	{
+		writeUInt(out, spans[i].numFaces);
+		writeUInt(out, spans[i].range.start);
+		writeUInt(out, spans[i].range.count);
+	}
+
+	return out.good();
+}
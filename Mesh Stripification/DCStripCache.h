@@ -0,0 +1,63 @@
+// ----------------------------------------
+// Class:		DCEL Strip Cache
+// Description:	Content-addressed binary cache of finished
+//				stripifier output
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTRIPCACHE
+#define DCSTRIPCACHE
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DCStripifier.h"
+
+// ----------------------------------------
+
+// Cache file extension
+#define DC_CACHE_EXTENSION ".dcc"
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// The key is a 64-bit FNV-1a hash of the model file bytes and of every
+// setting that changes the stripifier output, so an edited model or new
+// settings never hit an old entry. An entry holds the vertex array, the
+// index stream, the draw counts and the strip range table; a hit restores
+// them without loading the model into the DCEL.
+class DCStripCache
+{
+// ----------------------------------------
+private:
+	// Methods ----------------------------
+	static unsigned long long hashBytes(const void* data, unsigned int size, unsigned long long hash);
+	static unsigned long long hashUInt(unsigned int value, unsigned long long hash);
+
+// ----------------------------------------
+public:
+
+	// Key of a model file's bytes built with the given settings
+	static unsigned long long makeKey(const std::vector<char>& modelBytes, const DCStripSettings& settings);
+
+	// Key as 16 hexadecimal digits
+	static std::string getKeyName(unsigned long long key);
+
+	// Entry file name - the key name and extension
+	static std::string getFilename(unsigned long long key);
+
+	// Restores a built stripifier - false if the entry is missing, damaged or has another key.
+	// The stream must seek, so the array sizes can be checked against the bytes left
+	static bool load(std::istream& in, unsigned long long key, DCStripifier& stripifier);
+
+	// Writes the output of a built stripifier
+	static bool save(std::ostream& out, unsigned long long key, const DCStripifier& stripifier);
+};
+// ----------------------------------------
+
+#endif
@@ -0,0 +1,126 @@
+// ----------------------------------------
+// Class: DCEL Strip List source
+// ----------------------------------------
+
+// Include header
+#include "DCStripList.h"
+
+// Constructor
+DCStripList::DCStripList()
+{
+	starts.push_back(0);
+}
+
+// Destructor
+DCStripList::~DCStripList()
+{
+	// Empty
+}
+
+// Clear - capacity is kept for the next build
+void DCStripList::clear()
+{
+	faces.clear();
+	starts.assign(1, 0);
+}
+
+// Reserve
+void DCStripList::reserve(unsigned int numFaces)
+{
+	faces.reserve(numFaces);
+	starts.reserve(numFaces + 1);
+}
+
+// Add face
+void DCStripList::addFace(unsigned int face)
+{
+	faces.push_back(face);
+}
+
+// End strip
+void DCStripList::endStrip()
+{
+	if(faces.size() > starts.back())
+		starts.push_back(faces.size());
+}
+
+unsigned int DCStripList::getOpenLength() const
+{
+	return faces.size() - starts.back();
+}
+
+// Add strip
+void DCStripList::addStrip(const unsigned int* faces, unsigned int numFaces)
+{
+	this->faces.insert(this->faces.end(), faces, faces + numFaces);
+	endStrip();
+}
+
+// Append - offsets of the other list move past this list's faces
+void DCStripList::append(const DCStripList& strips)
+{
+	unsigned int offset = faces.size();
+
+	faces.insert(faces.end(), strips.faces.begin(), strips.faces.begin() + strips.starts.back());
+
+	for(unsigned int i = 1; i < strips.starts.size(); ++i)
+		starts.push_back(strips.starts[i] + offset);
+}
+
+// Reorder - copied into new arrays
+void DCStripList::reorder(const std::vector<unsigned int>& order)
+{
+	std::vector<unsigned int> reordered;
+	std::vector<unsigned int> reorderedStarts;
+
+	reordered.reserve(faces.size());
+	reorderedStarts.reserve(order.size() + 1);
+	reorderedStarts.push_back(0);
+
+	for(unsigned int i = 0; i < order.size(); ++i)
+	{
+		reordered.insert(reordered.end(), faces.begin() + starts[order[i]], faces.begin() + starts[order[i] + 1]);
+		reorderedStarts.push_back(reordered.size());
+	}
+
+	faces.swap(reordered);
+	starts.swap(reorderedStarts);
+}
+
+// Swap
+void DCStripList::swap(DCStripList& strips)
+{
+	faces.swap(strips.faces);
+	starts.swap(strips.starts);
+}
+
+// Getters
+unsigned int DCStripList::size() const
+{
+	return starts.size() - 1;
+}
+
+bool DCStripList::isEmpty() const
+{
+	return starts.size() == 1;
+}
+
+unsigned int DCStripList::getNumFaces() const
+{
+	return starts.back();
+}
+
+unsigned int DCStripList::getNumFaces(unsigned int strip) const
+{
+	return starts[strip + 1] - starts[strip];
+}
+
+const unsigned int* DCStripList::getFaces(unsigned int strip) const
+{
+	return &faces[starts[strip]];
+}
+
+unsigned long long DCStripList::getBytes() const
+{
+	return (unsigned long long)(faces.capacity() + starts.capacity()) * sizeof(unsigned int);
+}
@@ -0,0 +1,67 @@
+// ----------------------------------------
+// Class:		DCEL Strip List
+// Description:	Strips as face ids in one flat array, with
+//				the offset of each strip
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTRIPLIST
+#define DCSTRIPLIST
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Strip i holds the faces from starts[i] up to starts[i + 1]. A strip is
+// grown in place: faces are added after the last strip and endStrip
+// closes them into a new one. Strips are never removed - reordering copies
+// them into a new order, and the stripifier marks strips replaced by an
+// edit on their span instead.
+class DCStripList
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	std::vector<unsigned int> faces; // Every strip's faces, strip after strip
+	std::vector<unsigned int> starts; // First face of each strip, then the end of the last
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCStripList();
+	~DCStripList();
+
+	// Removes every strip
+	void clear();
+
+	// Room for strips over numFaces faces - there are never more strips than faces
+	void reserve(unsigned int numFaces);
+
+	// Strip being grown - faces after the last strip
+	void addFace(unsigned int face);
+	void endStrip(); // Closes the faces added into a strip, if any
+	unsigned int getOpenLength() const; // Faces added since the last strip
+
+	// Whole strips
+	void addStrip(const unsigned int* faces, unsigned int numFaces);
+	void append(const DCStripList& strips); // Every strip of another list, after this list's
+	void reorder(const std::vector<unsigned int>& order); // Strip i becomes strip order[i]
+	void swap(DCStripList& strips);
+
+	// Getters
+	unsigned int size() const; // Strips
+	bool isEmpty() const;
+	unsigned int getNumFaces() const; // Faces of every strip
+	unsigned int getNumFaces(unsigned int strip) const;
+	const unsigned int* getFaces(unsigned int strip) const;
+	unsigned long long getBytes() const; // Memory held by both arrays
+};
+// ----------------------------------------
+
+#endif
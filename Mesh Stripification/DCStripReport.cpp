@@ -0,0 +1,115 @@
+// ----------------------------------------
+// Class: DCEL Strip Report source
+// ----------------------------------------
+
+// Include header
+#include "DCStripReport.h"
+
+// Constructor
+DCMemoryUse::DCMemoryUse()
+{
+	peak = 0;
+	retained = 0;
+}
+
+// Constructor
+DCStripReport::DCStripReport()
+{
+	importTime = 0;
+	dcelTime = 0;
+	checkFacesTime = 0;
+	duplicationTime = 0;
+	degreeTime = 0;
+	stripTime = 0;
+	emitTime = 0;
+	uploadTime = 0;
+	cached = false;
+
+	faces = 0;
+	strips = 0;
+	indices = 0;
+	draws = 0;
+	submeshes = 0;
+	swaps = 0;
+	joinIndices = 0;
+	duplications = 0;
+
+	fetchLinesBefore = 0;
+	fetchLinesAfter = 0;
+	fetchDistanceBefore = 0;
+	fetchDistanceAfter = 0;
+}
+
+// Add strip length - into its power of two bucket
+void DCStripReport::addStripLength(unsigned int numFaces)
+{
+	unsigned int bucket = 0;
+
+	while(numFaces >> (bucket + 1))
+		++bucket;
+
+	if(stripLengths.size() <= bucket)
+		stripLengths.resize(bucket + 1, 0);
+
+	stripLengths[bucket] += 1;
+}
+
+// Sample memory
+void DCStripReport::sampleMemory(const std::string& name, unsigned long long bytes)
+{
+	unsigned int i = 0;
+
+	while(i < memory.size() && memory[i].name != name)
+		++i;
+
+	if(i == memory.size())
+	{
+		memory.push_back(DCMemoryUse());
+		memory[i].name = name;
+	}
+
+	if(bytes > memory[i].peak)
+		memory[i].peak = bytes;
+
+	memory[i].retained = bytes;
+}
+
+// Total time
+double DCStripReport::getTotalTime() const
+{
+	return importTime + dcelTime + checkFacesTime + duplicationTime + degreeTime + stripTime + emitTime + uploadTime;
+}
+
+// Write JSON
+void DCStripReport::writeJSON(std::ostream& out) const
+{
+	out << "{" << std::endl;
+
+	out << "  \"seconds\": {\"import\": " << importTime << ", \"dcel\": " << dcelTime << ", \"checkAllFaces\": " << checkFacesTime
+		<< ", \"duplication\": " << duplicationTime << ", \"degrees\": " << degreeTime << ", \"strips\": " << stripTime
+		<< ", \"emission\": " << emitTime << ", \"upload\": " << uploadTime << ", \"total\": " << getTotalTime() << "}," << std::endl;
+
+	out << "  \"cached\": " << (cached ? "true" : "false") << "," << std::endl;
+
+	out << "  \"faces\": " << faces << ", \"strips\": " << strips << ", \"indices\": " << indices << ", \"draws\": " << draws
+		<< ", \"submeshes\": " << submeshes << ", \"swaps\": " << swaps << ", \"joinIndices\": " << joinIndices << ", \"duplications\": " << duplications << "," << std::endl;
+
+	out << "  \"fetchLines\": {\"before\": " << fetchLinesBefore << ", \"after\": " << fetchLinesAfter
+		<< "}, \"fetchDistance\": {\"before\": " << fetchDistanceBefore << ", \"after\": " << fetchDistanceAfter << "}," << std::endl;
+
+	// Histogram buckets as [min, max, count]
+	out << "  \"stripLengths\": [";
+
+	for(unsigned int i = 0; i < stripLengths.size(); ++i)
+		out << (i ? ", " : "") << "[" << (1u << i) << ", " << (2u << i) - 1 << ", " << stripLengths[i] << "]";
+
+	out << "]," << std::endl;
+
+	out << "  \"memory\": {";
+
+	for(unsigned int i = 0; i < memory.size(); ++i)
+		out << (i ? "," : "") << std::endl << "    \"" << memory[i].name << "\": {\"peak\": " << memory[i].peak << ", \"retained\": " << memory[i].retained << "}";
+
+	out << std::endl << "  }" << std::endl;
+	out << "}" << std::endl;
+}
@@ -0,0 +1,83 @@
+// ----------------------------------------
+// Class:		DCEL Strip Report
+// Description:	Stage timings, strip statistics and memory
+//				use of one stripification
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTRIPREPORT
+#define DCSTRIPREPORT
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ----------------------------------------
+
+// Bytes held by one structure
+struct DCMemoryUse
+{
+	std::string name;
+	unsigned long long peak; // Largest size seen at the end of a stage
+	unsigned long long retained; // Size once the build is done
+
+	DCMemoryUse();
+};
+
+// Report of one model - stages not run are left at 0
+struct DCStripReport
+{
+	// Wall time per stage in seconds
+	double importTime; // Model file into a mesh definition - filled by the caller
+	double dcelTime; // Vertices and faces into the DCEL
+	double checkFacesTime; // checkAllFaces and unhandled triangles
+	double duplicationTime; // Face indices and seam duplication
+	double degreeTime; // Face degrees
+	double stripTime; // Strip growth, tunnelling and overdraw ordering
+	double emitTime; // Vertex array, index emission, joins and vertex reorder
+	double uploadTime; // Buffer creation - filled by the caller
+	bool cached; // Output loaded from the strip cache - no DCEL stages ran
+
+	// Output
+	unsigned int faces;
+	unsigned int strips;
+	unsigned int indices;
+	unsigned int draws;
+	unsigned int submeshes; // One per material
+	unsigned int swaps;
+	unsigned int joinIndices;
+	unsigned int duplications;
+
+	// Vertex fetch scatter of the index stream, before and after the vertex
+	// reorder - memory lines read and average distance in vertices between
+	// fetches, see DCCacheMetrics. 0 if vertices are not reordered
+	unsigned int fetchLinesBefore;
+	unsigned int fetchLinesAfter;
+	float fetchDistanceBefore;
+	float fetchDistanceAfter;
+
+	// Strip lengths in faces - bucket i counts strips of 2^i to 2^(i+1) - 1 faces
+	std::vector<unsigned int> stripLengths;
+
+	// Memory per structure
+	std::vector<DCMemoryUse> memory;
+
+	DCStripReport();
+
+	// Counts a strip of numFaces faces
+	void addStripLength(unsigned int numFaces);
+
+	// Records the current size of a structure - peaks are kept, the last size is retained
+	void sampleMemory(const std::string& name, unsigned long long bytes);
+
+	double getTotalTime() const;
+
+	// Writes the report as one JSON object
+	void writeJSON(std::ostream& out) const;
+};
+
+#endif
@@ -0,0 +1,200 @@
+// ----------------------------------------
+// Class:		DCEL Strip Tree
+// Description:	Globally informed strip growth - strips are
+//				paths cut from a spanning tree of the face
+//				dual graph
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTRIPTREE
+#define DCSTRIPTREE
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <queue>
+#include <vector>
+
+#include "DCStripBuilder.h"
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// The tree is grown over the open edges of the build's free faces with a
+// priority queue - edges of the newest tree face first, then the edge to
+// the neighbour with the fewest open edges, so faces are not left isolated,
+// then the edge turning the other way from the face's entry, so tree paths
+// zigzag as a strip without swaps. Roots are taken in queue order, lowest
+// degree first.
+//
+// The tree is then cut into the fewest paths: bottom up, each face joins
+// the path of up to two children that still end at themselves, and stays
+// open to its parent if it joined fewer than two. Paths longer than the
+// termination policy allows are split. O(F log F) over the build's faces.
+template <class Seam, class Termination>
+class DCStripTree
+{
+// ----------------------------------------
+private:
+	// Face of the tree - in the order faces joined it, so children follow their parents
+	struct Node
+	{
+		unsigned int face;
+		unsigned int parent; // Node - DC_NO_FACE for a root
+		unsigned int inSlot; // Slot of the edge to the parent
+		unsigned int turn; // Turn taken at the parent to reach the face - 0 if none
+		unsigned int links[2]; // Path neighbours
+		unsigned int numLinks;
+	};
+
+	// Add node - the face joins the tree and its open edges are queued
+	static void addNode(const DCStripContext& context, DCStripBuild& build, std::vector<Node>& nodes,
+		std::priority_queue<unsigned long long>& edges, unsigned int face, unsigned int parent, unsigned int parentSlot)
+	{
+		const std::vector<DCFaceAdjacency>& adjacency = *context.adjacency;
+
+		Node node;
+		node.face = face;
+		node.parent = parent;
+		node.inSlot = 0;
+		node.turn = 0;
+		node.numLinks = 0;
+
+		if(parent != DC_NO_FACE)
+		{
+			const Node& from = nodes[parent];
+
+			node.inSlot = adjacency[from.face].slots[parentSlot];
+
+			if(from.parent != DC_NO_FACE)
+				node.turn = (parentSlot + 3 - from.inSlot) % 3;
+		}
+
+		unsigned int id = nodes.size();
+
+		nodes.push_back(node);
+		build.treeNodes[face] = id;
+		build.faces[face].free = false;
+
+		// Key - node, then fewest open neighbour edges, then no swap, then lowest slot; the largest key leaves first
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			if(!DCOpenEdge<Seam>::isOpen(context, build, face, i))
+				continue;
+
+			unsigned int neighbour = adjacency[face].neighbours[i];
+			unsigned int open = 0;
+
+			for(unsigned int j = 0; j < 3; ++j)
+				if(DCOpenEdge<Seam>::isOpen(context, build, neighbour, j))
+					open += 1;
+
+			unsigned int noSwap = 1;
+
+			if(parent != DC_NO_FACE && (i + 3 - node.inSlot) % 3 == node.turn)
+				noSwap = 0;
+
+			edges.push(((unsigned long long)id << 5) | ((3 - open) << 3) | (noSwap << 2) | (3 - i));
+		}
+	}
+
+	// Link two nodes into one path
+	static void link(std::vector<Node>& nodes, unsigned int node1, unsigned int node2)
+	{
+		nodes[node1].links[nodes[node1].numLinks++] = node2;
+		nodes[node2].links[nodes[node2].numLinks++] = node1;
+	}
+
+// ----------------------------------------
+public:
+
+	// Strips over the build's queued faces - every queued face is used
+	static void stripFreeFaces(const DCStripContext& context, DCStripBuild& build)
+	{
+		const std::vector<DCFaceAdjacency>& adjacency = *context.adjacency;
+
+		if(build.treeNodes.size() != context.model->getNumFaces())
+			build.treeNodes.assign(context.model->getNumFaces(), DC_NO_FACE);
+
+		// Roots in queue order
+		std::vector<unsigned int> roots;
+
+		for(unsigned int face = build.freeFaces.getMin(); face != DC_NO_FACE; face = build.freeFaces.getMin())
+		{
+			roots.push_back(face);
+			build.freeFaces.remove(face);
+		}
+
+		// 1. Spanning forest
+		std::vector<Node> nodes;
+		std::priority_queue<unsigned long long> edges;
+
+		nodes.reserve(roots.size());
+
+		for(unsigned int i = 0; i < roots.size(); ++i)
+		{
+			if(build.treeNodes[roots[i]] != DC_NO_FACE)
+				continue;
+
+			addNode(context, build, nodes, edges, roots[i], DC_NO_FACE, 0);
+
+			while(!edges.empty())
+			{
+				unsigned int from = (unsigned int)(edges.top() >> 5);
+				unsigned int slot = 3 - (unsigned int)(edges.top() & 3);
+
+				edges.pop();
+
+				// Reached by an earlier edge
+				unsigned int face = adjacency[nodes[from].face].neighbours[slot];
+
+				if(build.treeNodes[face] == DC_NO_FACE)
+					addNode(context, build, nodes, edges, face, from, slot);
+			}
+		}
+
+		// 2. Fewest paths - children are decided before their parents
+		for(unsigned int i = nodes.size(); i-- > 0;)
+		{
+			unsigned int parent = nodes[i].parent;
+
+			if(parent != DC_NO_FACE && nodes[i].numLinks < 2 && nodes[parent].numLinks < 2)
+				link(nodes, i, parent);
+		}
+
+		// 3. Strips - each path from its first node, split where the termination policy ends it
+		for(unsigned int i = 0; i < nodes.size(); ++i)
+		{
+			if(nodes[i].numLinks == 2 || build.treeNodes[nodes[i].face] == DC_NO_FACE)
+				continue;
+
+			unsigned int prev = DC_NO_FACE;
+			unsigned int node = i;
+
+			while(node != DC_NO_FACE)
+			{
+				if(build.strips.getOpenLength() && Termination::isDone(context, build.strips))
+					build.strips.endStrip();
+
+				build.strips.addFace(nodes[node].face);
+				build.treeNodes[nodes[node].face] = DC_NO_FACE; // Walked
+
+				// Next node along the path
+				unsigned int next = DC_NO_FACE;
+
+				for(unsigned int j = 0; j < nodes[node].numLinks; ++j)
+					if(nodes[node].links[j] != prev)
+						next = nodes[node].links[j];
+
+				prev = node;
+				node = next;
+			}
+
+			build.strips.endStrip();
+		}
+	}
+};
+// ----------------------------------------
+
+#endif
@@ -5,132 +5,168 @@
 // Include header
 #include "DCStripification.h"
 
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
 // Ensure correct namespace use
 using namespace std;
 
+// Wall clock seconds since start
+static double secondsSince(chrono::high_resolution_clock::time_point start)
+{
+	return chrono::duration_cast< chrono::duration<double> >(chrono::high_resolution_clock::now() - start).count();
+}
+
 // Constructor
-DCStripification::DCStripification(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, bool stripify)
+DCStripification::DCStripification(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, bool stripify, DCStripOutput output)
+{
+	// Set stripification settings
+	DCStripSettings settings;
+	settings.stripify = stripify;
+	settings.output = output;
+	settings.maxLength = 500;
+
+	create(device, vsBytecode, modelFilename, textureFilename, settings, true);
+}
+
+// Constructor - full stripifier settings
+DCStripification::DCStripification(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, const DCStripSettings& settings)
+{
+	create(device, vsBytecode, modelFilename, textureFilename, settings, false);
+}
+
+// Create - load, stripify and upload
+void DCStripification::create(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, DCStripSettings settings, bool tuned)
 {
 	// Default buffer settings
 	vertexBuffer = NULL;
 	indexBuffer = NULL;
+	indexCapacity = 0;
 	inputLayout = NULL;
-	texCoords = NULL;
-	textured = true;
+	textureResourceView = NULL;
+	sampler = NULL;
 
-	// Set stripification settings
-	this->stripify = stripify;
-	maxLength = 500;
+	// Cached output - keyed by the model file bytes and the settings
+	std::vector<char> modelBytes;
+	std::wstring cacheFilename;
+	unsigned long long cacheKey = 0;
+	bool cached = false;
+
+	if(readModelFile(modelFilename, modelBytes))
+	{
+		// Tuning file - written by the autotuner for these model bytes
+		if(tuned)
+		{
+			std::ifstream tuneFile((std::wstring(modelFilename) + L"" DC_TUNE_EXTENSION).c_str());
+
+			if(tuneFile && DCAutotuner::load(tuneFile, DCAutotuner::makeKey(modelBytes), settings))
+				cerr << "Tuned settings loaded - maxLength " << settings.maxLength << "." << endl;
+		}
+
+		cacheKey = DCStripCache::makeKey(modelBytes, settings);
+
+		std::string name = DCStripCache::getFilename(cacheKey);
+		cacheFilename = std::wstring(DC_CACHE_DIRECTORY) + std::wstring(name.begin(), name.end());
+
+		std::ifstream in(cacheFilename.c_str(), ios::binary);
+		cached = in && DCStripCache::load(in, cacheKey, stripifier);
+	}
+
+	stripifier.setSettings(settings);
+
+	if(cached)
+	{
+		cerr << "Strips loaded from the cache." << endl;
+
+		report = stripifier.getReport();
+		report.cached = true;
+	}
+	else
+	{
+		// Load model
+		chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+		DCMeshDef meshDef;
+		loadModel(modelFilename, meshDef);
 
-	// Ensure cleared vector
-	duplications.clear();
+		double importSeconds = secondsSince(start);
 
-	// Load model
-	loadModel(modelFilename);
+		// Stripify
+		stripifier.loadMesh(meshDef);
+		stripifier.build();
+
+		report = stripifier.getReport();
+		report.importTime = importSeconds;
+
+		// Save for the next run
+		if(!cacheFilename.empty())
+		{
+			CreateDirectoryW(DC_CACHE_DIRECTORY, NULL);
+
+			std::ofstream out(cacheFilename.c_str(), ios::binary);
+
+			if(!out || !DCStripCache::save(out, cacheKey, stripifier))
+				cerr << "Strips cannot be saved to the cache." << endl;
+		}
+	}
 
 	// Load texture
 	loadResources(device, textureFilename);
 
 	// Setup buffers
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
 	setupBuffers(device, vsBytecode);
+
+	report.uploadTime = secondsSince(start);
+
+	cerr << "Model ready in " << report.getTotalTime() << "s." << endl;
 }
 
 // Destructor
 DCStripification::~DCStripification()
 {
 	// Clean memory
-	duplications.clear();
-
-	if(texCoords)
-		delete texCoords;
-
 	if(textureResourceView)
 		delete textureResourceView;
 
 	if(sampler)
 		delete sampler;
+
+	for(unsigned int i = 0; i < materialTextures.size(); ++i)
+		if(materialTextures[i])
+			materialTextures[i]->Release();
 }
 
-// Buffer setup
+// Buffer setup - upload the stripifier output
 void DCStripification::setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode)
 {
+	const std::vector<DCStripVertex>& stripVertices = stripifier.getVertices();
+
 	// Fills the Direct X buffers
 	CGVertexExt* vertices = NULL;
-	DWORD* indices = NULL;
 
-	// Vertex counter
-	vertices = (CGVertexExt*) malloc (sizeof(CGVertexExt) * (model.getNumVertices() + duplications.size()));
+	vertices = (CGVertexExt*) malloc (sizeof(CGVertexExt) * stripVertices.size());
+	ZeroMemory(vertices, sizeof(CGVertexExt) * stripVertices.size());
 
 	// Setup vertex array
-	for(unsigned int i = 0; i < model.getNumVertices(); ++i)
-	{
-		// Get vertex
-		DCMesh::Vertex* vert = model.getVertex(i);
-
-		// Set position data
-		vertices[i].pos.x = vert->getData().position.x;
-		vertices[i].pos.y = vert->getData().position.y;
-		vertices[i].pos.z = vert->getData().position.z;
-
-		// Set normal data
-		vertices[i].normal.x += vert->getData().normal.x;
-		vertices[i].normal.y += vert->getData().normal.y;
-		vertices[i].normal.z += vert->getData().normal.z;
-	}
-
-	// Index counter
-	unsigned int count = 0;
-
-	// Create vertex duplications
-	for(std::list<vDuplication>::iterator dupeIt = duplications.begin();
-		dupeIt != duplications.end(); ++dupeIt)
+	for(unsigned int i = 0; i < stripVertices.size(); ++i)
 	{
-		// Get vertex
-		DCMesh::Vertex* vert = model.getVertex(dupeIt->vertIndex);
-
 		// Set position data
-		vertices[model.getNumVertices() + count].pos.x = vert->getData().position.x;
-		vertices[model.getNumVertices() + count].pos.y = vert->getData().position.y;
-		vertices[model.getNumVertices() + count].pos.z = vert->getData().position.z;
+		vertices[i].pos.x = stripVertices[i].pos[0];
+		vertices[i].pos.y = stripVertices[i].pos[1];
+		vertices[i].pos.z = stripVertices[i].pos[2];
 
 		// Set normal data
-		vertices[model.getNumVertices() + count].normal.x += vert->getData().normal.x;
-		vertices[model.getNumVertices() + count].normal.y += vert->getData().normal.y;
-		vertices[model.getNumVertices() + count].normal.z += vert->getData().normal.z;
+		vertices[i].normal.x = stripVertices[i].normal[0];
+		vertices[i].normal.y = stripVertices[i].normal[1];
+		vertices[i].normal.z = stripVertices[i].normal[2];
 
-		// Increment counter
-		count += 1;
-	}
-
-	// Setup indexes based on stripification setting
-	if(stripify)
-		indices = setupStripification(device); // Stripification
-	else
-		indices = setupIndexBuffer(device); // Normal setup
-
-	// Reset counter
-	count = 0;
-
-	// Setup texture index array
-	if(textured)
-	{
-		for(unsigned int i = 0; i < model.getNumFaces(); ++i)
-		{
-			for(unsigned int j = 0; j < 3; ++j)
-			{
-				// Get face
-				DCMesh::Face* face = model.getFace(i);
-
-				// Setup texture coordinates
-				vertices[face->getData().v[j]].texCoord.x = texCoords[face->getData().t[j]].s;
-				vertices[face->getData().v[j]].texCoord.y = 1 - texCoords[face->getData().t[j]].t;
-
-				// iterate count
-				count += 1;
-			}
-		}
+		// Setup texture coordinates
+		vertices[i].texCoord.x = stripVertices[i].texCoord[0];
+		vertices[i].texCoord.y = 1 - stripVertices[i].texCoord[1];
 	}
 
 	// Buffer setup
@@ -141,7 +177,7 @@ void DCStripification::setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode)
 	ZeroMemory(&vertexData, sizeof(D3D11_SUBRESOURCE_DATA));
 
 	vertexDesc.Usage = D3D11_USAGE_IMMUTABLE;
-	vertexDesc.ByteWidth = sizeof(CGVertexExt) * (model.getNumVertices() + duplications.size());
+	vertexDesc.ByteWidth = sizeof(CGVertexExt) * stripVertices.size();
 	vertexDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 	vertexData.pSysMem = vertices;
 
@@ -154,8 +190,7 @@ void DCStripification::setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode)
 	if(vertices)
 		free(vertices);
 
-	if(indices)
-		free(indices);
+	setupIndexBuffer(device);
 
 	hr = CGVertexExt::createInputLayout(device, vsBytecode, &inputLayout);
 
@@ -163,403 +198,131 @@ void DCStripification::setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode)
 		throw("Cannot create input layout interface");
 }
 
-// Setup index buffer - Standard: No stripification
-DWORD* DCStripification::setupIndexBuffer(ID3D11Device *device)
+// Index buffer setup - default usage, so edits can patch it in place, with headroom
+// for the strips they append
+void DCStripification::setupIndexBuffer(ID3D11Device *device)
 {
-	// Normal index setup
-	DWORD* indices = NULL;
-
-	indices = (DWORD*) malloc (sizeof(DWORD) * (model.getNumFaces() * 3));
-
-	// Index counter
-	unsigned int count = 0;
-
-	// Setup index array
-	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	if(indexBuffer)
 	{
-		for(unsigned int j = 0; j < 3; ++j)
-		{
-			// Setup vertex indices
-			indices[count] = model.getFace(i)->getData().v[j];
-
-			// iterate count;
-			count += 1;
-		}
+		indexBuffer->Release();
+		indexBuffer = NULL;
 	}
 
-	// Setup index data
-	D3D11_BUFFER_DESC indexDesc;
-	D3D11_SUBRESOURCE_DATA indexData;
-
-	ZeroMemory(&indexDesc, sizeof(D3D11_BUFFER_DESC));
-	ZeroMemory(&indexData, sizeof(D3D11_SUBRESOURCE_DATA));
-
-	indexDesc.Usage = D3D11_USAGE_IMMUTABLE;
-	indexDesc.ByteWidth = sizeof(DWORD) * (model.getNumFaces() * 3);
-	indexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-	indexData.pSysMem = indices;
-
-	HRESULT hr = device->CreateBuffer(&indexDesc, &indexData, &indexBuffer);
-
-	if (!SUCCEEDED(hr))
-		throw("Index buffer cannot be created");
+	indexCapacity = 0;
 
-	return indices;
-}
+	// Pack indices - 16-bit where the settings and vertex ranges allow
+	DCIndexPacker::pack(stripifier.getIndices(), stripifier.getDrawCounts(), stripifier.getSettings().stripify, stripifier.getSettings().indexFormat, packedIndices);
 
-// Setup index buffer - Stripified
-DWORD* DCStripification::setupStripification(ID3D11Device *device)
-{
-	// Index buffer for stripification
-	DWORD* indices = NULL;
-	std::vector<unsigned int> indexVec;
+	setupDrawMaterials();
 
-	cerr << "Stripifiying Mesh..." << endl;
+	cerr << stripifier.getSubmeshes().size() << " submeshes." << endl;
 
-	// 1. Select face with the most neighbours (free)
-	DCMesh::Face* face = getFreeFace();
+	cerr << packedIndices.getBytes() << " index bytes (" << stripifier.getIndices().size() * sizeof(DWORD) << " as 32-bit)." << endl;
 
-	// Loop while there is a free face
-	while(face)
+	// Nothing to draw when every face is hidden, and D3D rejects empty buffers
+	if(!packedIndices.getBytes())
 	{
-		// 2. Create strip from face
-		createStrip(face);
-
-		// Get the next free face
-		face = getFreeFace();
+		cerr << "No indices - the model is not drawn." << endl;
+		return;
 	}
 
-	cerr << strips.size() << " strips created." << endl;
-
-	// 3. Setup strip index buffer
-	for(stripsIt = strips.begin(); stripsIt != strips.end(); ++stripsIt)
-	{
-		// Pointer to strip vector
-		std::vector<unsigned int>* strip = *stripsIt;
-		int swapCount = 0;
-
-		// Loop through each of the faces in the strip and add the indices
-		for(unsigned int i = 0; i < strip->size(); ++i)
-		{
-			// 1. Add verticies to the strip - from stand alone vertex
-			if(i == 0)
-			{
-				// If it is the first face in the strip
-				// Find the standalone vertex
-				bool found = false;
-				int j = 0;
-
-				// Check for single triangle strip
-				if(strip->size() > 1)
-				{
-					while(j < 3 && !found)
-					{
-						for(int k = 0; k < 3; ++k)
-						{
-							if(model.getFace((*strip)[i])->getData().v[j] == model.getFace((*strip)[i + 1])->getData().v[k])
-							{
-								found = true;
-							}
-						}
-
-						// The standalone has been found
-						if(!found)
-						{
-							indexVec.push_back(model.getFace((*strip)[i])->getData().v[j]);
-
-							if(j + 1 < 3)
-								indexVec.push_back(model.getFace((*strip)[i])->getData().v[j + 1]);
-							else
-								indexVec.push_back(model.getFace((*strip)[i])->getData().v[0]);
-
-							if(j + 2 < 3)
-								indexVec.push_back(model.getFace((*strip)[i])->getData().v[j + 2]);
-							else
-								indexVec.push_back(model.getFace((*strip)[i])->getData().v[(j + 2) - 3]);
-						}
-						else
-							found = false;
-
-						// Increment j
-						++j;
-					}
-				}
-				else
-				{
-					for(int k = 0; k < 3; ++k)
-						indexVec.push_back(model.getFace((*strip)[i])->getData().v[k]);
-				}
-			}
-			// 2. Increment i, adding the next triangle
-			else
-			{
-				bool found = false;
-				int j = 0;
-
-				// 3. Consider the existance of i + 1
-				if(i == strip->size() - 1)
-					// If no, add the other vertex of i
-					indexVec.push_back(otherVertex(model.getFace((*strip)[i]), model.getFace((*strip)[i - 1])));
-				// If yes, find the common vertex between i - 1 and i + 1
-				else
-				{
-					// Find common vertex in i - 1 and i + 1
-					unsigned int common = commonVertex(model.getFace((*strip)[i - 1]), model.getFace((*strip)[i + 1]));
-
-					// If the common vertex is the 'tail' of the strip, add the 'other vertex'
-					if(indexVec.back() == common)
-						indexVec.push_back(otherVertex(model.getFace((*strip)[i]), model.getFace((*strip)[i - 1])));
-					// If not, add the common vertex to the strip (swap), then add the 'other vertex'
-					else
-					{
-						indexVec.push_back(common);
-						indexVec.push_back(otherVertex(model.getFace((*strip)[i]), model.getFace((*strip)[i - 1])));
-
-						// A swap has occured - increment count
-						++swapCount;
-					}
-				}
-			}
-		}
-
-		// DIRT.lib
-		(*strip).resize((*strip).size() + swapCount);
-	}
+	unsigned int numIndices = packedIndices.getNumIndices();
+	unsigned int capacity = numIndices + numIndices / DC_INDEX_HEADROOM;
 
-	// Allocate index buffer memory
-	indices = (DWORD*) malloc (sizeof(DWORD) * indexVec.size());
+	// Initial data must fill the buffer - the headroom is zeroed
+	std::vector<char> bytes(capacity * packedIndices.getIndexSize(), 0);
 
-	// Copy index values
-	for(unsigned int i = 0; i < indexVec.size(); ++i)
-	{
-		indices[i] = indexVec[i];
-		//cerr << indices[i] << ", ";
-	}
+	if(packedIndices.format == DC_INDEX_16)
+		memcpy(&bytes[0], &packedIndices.indices16[0], packedIndices.getBytes());
+	else
+		memcpy(&bytes[0], &packedIndices.indices32[0], packedIndices.getBytes());
 
-	// Setup index data
 	D3D11_BUFFER_DESC indexDesc;
 	D3D11_SUBRESOURCE_DATA indexData;
 
 	ZeroMemory(&indexDesc, sizeof(D3D11_BUFFER_DESC));
 	ZeroMemory(&indexData, sizeof(D3D11_SUBRESOURCE_DATA));
 
-	indexDesc.Usage = D3D11_USAGE_IMMUTABLE;
-	indexDesc.ByteWidth = sizeof(DWORD) * indexVec.size();
+	indexDesc.Usage = D3D11_USAGE_DEFAULT;
+	indexDesc.ByteWidth = bytes.size();
 	indexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-	indexData.pSysMem = indices;
+	indexData.pSysMem = &bytes[0];
 
 	HRESULT hr = device->CreateBuffer(&indexDesc, &indexData, &indexBuffer);
 
 	if (!SUCCEEDED(hr))
 		throw("Index buffer cannot be created");
 
-	return indices;
+	indexCapacity = capacity;
 }
 
-// Create strip
-void DCStripification::createStrip(DCMesh::Face* face)
+// Draw materials - each packed draw's from the submesh holding its draw
+void DCStripification::setupDrawMaterials()
 {
-	// Strip - list of face indexes
-	std::vector<unsigned int>* strip;
-
-	// Get the first face to stripify and create new strip
-	strip = new vector<unsigned int>;
-
-	// Loop exit conditions
-	unsigned int i = 0;
-	bool exit = false; // Used for if there are no neighbours
-
-	// Faces added to strip iteratively
-	while(i < maxLength && !exit)
-	{
-		// Add the first triangle to the strip
-		strip->push_back(model.getFaceId(face));
-		
-		// Update face free status
-		face->getData().free = 0;
-
-		// Search face neighbours - update free and select next face (based on degree)
-		EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(face); // Create edge iterator
-
-		// Update neighbours
-		for(int j = 0; j < 3; ++j)
-		{
-			DCMesh::Face* testFace = edgeIt.getNext()->getTwin()->getFace();
-
-			// Check if the face exists
-			if(testFace)
-				testFace->getData().degree -= 1;
-		}
+	const std::vector<DCSubmesh>& submeshes = stripifier.getSubmeshes();
+	std::vector<unsigned int> materials(stripifier.getDrawCounts().size(), 0);
 
-		// Get next face to add to strip and iterate
-		face = getNextFace(face);
+	for(unsigned int i = 0; i < submeshes.size(); ++i)
+		for(unsigned int j = 0; j < submeshes[i].numDraws; ++j)
+			materials[submeshes[i].firstDraw + j] = submeshes[i].material;
 
-		// GetNextFace will return NULL if no neighbours are found
-		if(!face)
-			exit = true;
+	drawMaterials.resize(packedIndices.draws.size());
 
-		// Iterate
-		++i;
-	}
-
-	// Once strip has been completed - or reached maxLength; add to list
-	strips.push_back(strip);
+	for(unsigned int i = 0; i < packedIndices.draws.size(); ++i)
+		drawMaterials[i] = materials[packedIndices.draws[i].draw];
 }
 
-// Get free face - with lowest degree
-DCMesh::Face* DCStripification::getFreeFace()
+// Edit mesh - patched ranges are packed and uploaded into the existing buffer; a
+// chunked stream, or one past the buffer's capacity, gets a new buffer
+void DCStripification::editMesh(ID3D11Device *device, ID3D11DeviceContext *context, const DCMeshEdit& edit)
 {
-	DCMesh::Face* selected = NULL;
+	stripifier.editMesh(edit);
 
-	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
-	{
-		if(model.getFace(i)->getData().free)
-		{
-			// If selected is not
-			if(!selected)
-				selected = model.getFace(i);
-			else if(model.getFace(i)->getData().degree < selected->getData().degree)
-				selected = model.getFace(i);
-		}
-	}
+	const std::vector<unsigned int>& indices = stripifier.getIndices();
+	const std::vector<DCIndexRange>& ranges = stripifier.getPatchedRanges();
 
-	return selected;
-}
+	if(ranges.empty())
+		return;
 
-// Get Next Face - Free/Low degree/Not texture seam
-DCMesh::Face* DCStripification::getNextFace(DCMesh::Face* face)
-{
-	// Check if current face has no neighbours
-	if(face->getData().degree != 0)
+	if(!indexBuffer || indices.size() > indexCapacity ||
+		!DCIndexPacker::patch(indices, stripifier.getDrawCounts(), stripifier.getSettings().stripify, ranges, packedIndices))
 	{
-		// Variable for selected face
-		DCMesh::Face* selected = NULL;
-
-		// Edge iterator to get neighbours
-		EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(face);
-
-		// Loop through neighbours
-		for(unsigned int i = 0; i < 3; ++i)
-		{
-			// Get neighbour
-			DCMesh::Face* neighbour = edgeIt.getNext()->getTwin()->getFace();
-
-			// Check if the face is on a texture seam - not considered
-			if(neighbour) // Check if neighbour exists
-			{
-				if(!isTextureSeam(face, neighbour) && neighbour->getData().free)
-				{
-					// Check if the neighbour has a degree of 0
-					if(neighbour->getData().degree == 0)
-						return neighbour;
-
-					// If it is not on a texture seam - check degree against others
-					if(!selected) // If the selected face has not been set
-						selected = neighbour;
-					// If selected has been set, check against neighbour
-					else if(neighbour->getData().degree < selected->getData().degree)
-						selected = neighbour; // Reassign selected to lowest degree
-				}
-			}
-		}
-
-		// Once each neighbour has been checked - return best face to add to strip
-		return selected;
+		setupIndexBuffer(device);
+		return;
 	}
-	else
-		return NULL;
-}
-
-// Check texture seam
-bool DCStripification::isTextureSeam(DCMesh::Face* face1, DCMesh::Face* face2)
-{
-	if(textured)
-	{
-		// A count for the number of different indices
-		int difference = 0;
-
-		// If the index is found
-		bool found = false;
 
-		// If there is more than a single different index - there is a texture seam
-		for(int i = 0; i < 3; ++i)
-		{
-			for(int j = 0; j < 3; ++j)
-				if(face1->getData().v[i] == face2->getData().v[j])
-					found = true;
-
-			if(!found)
-				difference += 1;
-
-			// Reset found
-			found = false;
-		}
-
-		// Returns 1 if there is more than a single difference
-		if(difference > 1)
-			return 1;
-		else
-			return 0;
-	}
-	else
-		return 0;
-}
+	setupDrawMaterials();
 
-// Other vertex - returns index of face1's other vertex
-unsigned int DCStripification::otherVertex(DCMesh::Face* face1, DCMesh::Face* face2)
-{
-	int count = 0;
-	bool found = false;
+	// Upload the patched ranges only
+	unsigned int indexSize = packedIndices.getIndexSize();
+	unsigned int patched = 0;
 
-	// Returns the other vertex in [FACE 1] compared to face2
-	while(count < 3 && !found)
+	for(unsigned int i = 0; i < ranges.size(); ++i)
 	{
-		for(int i = 0; i < 3; ++i)
-		{
-			if(face1->getData().v[count] == face2->getData().v[i])
-				found = true;
-		}
-
-		// If the vertex is found - it is not 'other'
-		// If it isn't - it is the other
-		if(!found)
-			return face1->getData().v[count];
+		if(!ranges[i].count)
+			continue;
+
+		D3D11_BOX box;
+		box.left = ranges[i].start * indexSize;
+		box.right = (ranges[i].start + ranges[i].count) * indexSize;
+		box.top = 0;
+		box.bottom = 1;
+		box.front = 0;
+		box.back = 1;
+
+		if(packedIndices.format == DC_INDEX_16)
+			context->UpdateSubresource(indexBuffer, 0, &box, &packedIndices.indices16[ranges[i].start], 0, 0);
 		else
-			found = false;
+			context->UpdateSubresource(indexBuffer, 0, &box, &packedIndices.indices32[ranges[i].start], 0, 0);
 
-		// Increment count
-		++count;
+		patched += ranges[i].count;
 	}
-}
-
-// Common vertex
-unsigned int DCStripification::commonVertex(DCMesh::Face* face1, DCMesh::Face* face2)
-{
-	int count = 0;
-	bool found = false;
 
-	// Returns the common vertex in face1 and face2
-	while(count < 3 && !found)
-	{
-		for(int i = 0; i < 3; ++i)
-		{
-			if(face1->getData().v[count] == face2->getData().v[i])
-				found = true;
-		}
-
-		// If the vertex is found - it is 'common'
-		if(found)
-			return face1->getData().v[count];
-		else
-			found = false;
-
-		// Increment count
-		++count;
-	}
+	cerr << patched * indexSize << " index bytes uploaded." << endl;
 }
 
-// Load Model
-void DCStripification::loadModel(wchar_t* filename)
+// Load Model - CGImport3 into a mesh definition
+void DCStripification::loadModel(wchar_t* filename, DCMeshDef& meshDef)
 {
 	// 1. Create new model file
 	CGModel* import = new CGModel();
@@ -572,108 +335,61 @@ void DCStripification::loadModel(wchar_t* filename)
 
 	// 3. Make a copy to access private attributes
 	CGPolyMesh* meshCopy = new CGPolyMesh(import->getMeshAtIndex(0));
-	
+
 	// Aquire private attributes
 	CGBaseMeshDefStruct* meshData = new CGBaseMeshDefStruct();
 	meshCopy->createMeshDef(meshData);
 
-	// DEBUG
-	cerr << "Reserving memory for: " << endl;
-	cerr << meshData->N << " vertices;" << endl;
-	cerr << meshData->n << " faces;" << endl;
-	cerr << (2 * (3 * meshData->n)) << " half-edges." << endl;
-
-	// Clear model data and reserve space
-	model.clear();
-    model.getVertices().reserve(meshData->N);
-    model.getFaces().reserve(meshData->n);
-    model.getHalfEdges().reserve(2 * (3 * meshData->n));
-
-	// DEBUG
-	cerr << "Populating DCEL structure..." << endl;
-	cerr << "Populating vertices..." << endl;
+	// 4. Copy vertices - position and normals
+	meshDef.positions.resize(meshData->N * 3);
+	meshDef.normals.resize(meshData->N * 3);
 
-	// 4. Fill the DCEL with data from the imported obj
-	// Create vertices
 	for(int i = 0; i < meshData->N; ++i)
 	{
-		// Create new vertex
-		DCMesh::Vertex* vert = model.createGetVertex();
+		CoreStructures::GUVector4 normal = meshData->Vn[i].unitVector();
 
-		// Set data - position, normals and texture coordinates
-		vert->getData().setPosition(meshData->V[i]);
-		vert->getData().setNormal(meshData->Vn[i].unitVector());
+		meshDef.positions[i * 3] = meshData->V[i].x;
+		meshDef.positions[i * 3 + 1] = meshData->V[i].y;
+		meshDef.positions[i * 3 + 2] = meshData->V[i].z;
+
+		meshDef.normals[i * 3] = normal.x;
+		meshDef.normals[i * 3 + 1] = normal.y;
+		meshDef.normals[i * 3 + 2] = normal.z;
 	}
 
-	// Check for texture coordinates
-	if(meshData->VtSize)
-	{
-		// Copy texture coordinates
-		// Allocate memory
-		texCoords = (CoreStructures::CGTextureCoord*) malloc (sizeof(CoreStructures::CGTextureCoord) * meshData->VtSize);
+	// Copy texture coordinates
+	meshDef.texCoords.resize(meshData->VtSize * 2);
 
-		for(int i = 0; i <  meshData->VtSize; ++i)
-			texCoords[i] = (*meshData).Vt[i];
+	for(int i = 0; i < meshData->VtSize; ++i)
+	{
+		meshDef.texCoords[i * 2] = meshData->Vt[i].s;
+		meshDef.texCoords[i * 2 + 1] = meshData->Vt[i].t;
 	}
-	else
-		// There are no texture coordinates - dont load them
-		textured = false;
 
-	// DEBUG
-	cerr << "Populating faces..." << endl;
+	// Copy faces - triangular
+	meshDef.faceVertices.resize(meshData->n * 3);
 
-	// Create faces - triangular
-	for(int i = 0; i < meshData->n; ++i)
-		model.createTriangularFace(meshData->Fv[i].v1, meshData->Fv[i].v2, meshData->Fv[i].v3);
-
-	// Check faces & Manage unhandled
-	model.checkAllFaces();
-	model.manageUnhandledTriangles();
+	if(meshData->VtSize)
+		meshDef.faceTexCoords.resize(meshData->n * 3);
 
-	// Setup faces
-	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	for(int i = 0; i < meshData->n; ++i)
 	{
-		// Create new face
-		DCMesh::Face* face = model.getFace(i);
+		meshDef.faceVertices[i * 3] = meshData->Fv[i].v1;
+		meshDef.faceVertices[i * 3 + 1] = meshData->Fv[i].v2;
+		meshDef.faceVertices[i * 3 + 2] = meshData->Fv[i].v3;
 
-		// Per-face indices
-		face->getData().setIndices(meshData->Fv[i].v1, meshData->Fv[i].v2, meshData->Fv[i].v3);
+		// Per-face material - 0 for none
+		if(meshData->Ma)
+			meshDef.faceMaterials.push_back(meshData->Ma[i].materialID);
 
-		// Duplicate faces are not needed if there are no texture coordinates
-		if(textured)
+		if(meshData->VtSize)
 		{
-			// Per-face texture coordinates
-			face->getData().setTexIndices(meshData->Fvt[i].t1, meshData->Fvt[i].t2, meshData->Fvt[i].t3);
-
-			// Check for vertex duplications - texture coordinate seams
-			checkDuplication(model.getVertex(meshData->Fv[i].v1), face, meshData->Fvt[i].t1, 0);
-			checkDuplication(model.getVertex(meshData->Fv[i].v2), face, meshData->Fvt[i].t2, 1);
-			checkDuplication(model.getVertex(meshData->Fv[i].v3), face, meshData->Fvt[i].t3, 2);
+			meshDef.faceTexCoords[i * 3] = meshData->Fvt[i].t1;
+			meshDef.faceTexCoords[i * 3 + 1] = meshData->Fvt[i].t2;
+			meshDef.faceTexCoords[i * 3 + 2] = meshData->Fvt[i].t3;
 		}
 	}
 
-	// DEBUG
-	cerr << duplications.size() << " duplicated vertices." << endl;
-	cerr << model.getNumHalfEdges() << " half-edges created." << endl;
-
-	// Resize half-edge vector to save memory
-	model.getHalfEdges().resize(model.getNumHalfEdges());
-
-	cerr << "Linking faces... " << endl;
-
-	// Loop through faces - alter degree
-	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
-	{
-		// Create edge iterator
-		EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(model.getFace(i));
-
-		// Check neighbours
-		for(int j = 0; j < 3; ++j)
-			edgeIt.getNext()->getFace()->getData().degree += 1; // Add to number of neighbours
-	}
-
-	cerr << "Done!" << endl;
-
 	// 5. Clean up imported data - we have copied the data we need
 	if(meshData)
 		delete meshData;
@@ -685,6 +401,24 @@ void DCStripification::loadModel(wchar_t* filename)
 		delete import;
 }
 
+// Read model file - whole file into bytes
+bool DCStripification::readModelFile(wchar_t* filename, std::vector<char>& bytes)
+{
+	std::ifstream in(filename, ios::binary);
+
+	if(!in)
+		return false;
+
+	in.seekg(0, ios::end);
+	bytes.resize((unsigned int)in.tellg());
+	in.seekg(0, ios::beg);
+
+	if(!bytes.empty())
+		in.read(&bytes[0], bytes.size());
+
+	return in.good();
+}
+
 // Loads shader and rexture resources
 void DCStripification::loadResources(ID3D11Device* device, wchar_t* filename)
 {
@@ -709,67 +443,37 @@ void DCStripification::loadResources(ID3D11Device* device, wchar_t* filename)
 	device->CreateSamplerState(&linearDesc, &sampler);
 }
 
-// Duplication check
-void DCStripification::checkDuplication(DCMesh::Vertex* vert, DCMesh::Face* face, unsigned int texIndex, int faceVertIndex)
+// Load material texture - replaces an earlier one for the material
+void DCStripification::loadMaterialTexture(ID3D11Device *device, unsigned int material, wchar_t* filename)
 {
-	if(vert->getData().set) // Texture coord has been set
-	{
-		if(vert->getData().texIndex != texIndex)
-		{
-			bool found = false;
-			unsigned int index = 0;
-
-			// Check if the duplication has been recorded before
-			std::list<vDuplication>::iterator dupeIt = duplications.begin();
-
-			while(dupeIt != duplications.end() && !found)
-			{
-				// If the duplication has happened before
-				if(dupeIt->vertIndex == model.getVertexId(vert) && dupeIt->texIndex == texIndex)
-				{
-					// Set the vertex to the same index
-					face->getData().v[faceVertIndex] = (model.getNumVertices() + index);
-					found = true; // Exit condition
-				}
-
-				// Increment
-				++dupeIt;
-				++index;
-			}
-
-			// If the duplication is new
-			if(!found)
-			{
-				// Record duplication
-				vDuplication duplication;
-
-				duplication.vertIndex = model.getVertexId(vert);
-				duplication.texIndex = texIndex;
-
-				duplications.push_back(duplication);
-
-				// Alter face index
-				face->getData().v[faceVertIndex] = (model.getNumVertices() + duplications.size()) - 1;
-			}
-		}
-	}
-	else
-	{
-		vert->getData().set = 1;
-		vert->getData().texIndex = texIndex;
-	}
+	if(material >= materialTextures.size())
+		materialTextures.resize(material + 1, NULL);
+
+	if(materialTextures[material])
+		materialTextures[material]->Release();
+
+	materialTextures[material] = NULL;
+
+	if(!SUCCEEDED(D3DX11CreateShaderResourceViewFromFile(device, filename, 0, 0, &materialTextures[material], 0)))
+		throw("Cannot load material texture");
+}
+
+// Getters
+const DCStripReport& DCStripification::getReport() const
+{
+	return report;
 }
 
 // Render
 void DCStripification::render(ID3D11DeviceContext *context)
 {
-	// Link texture to shader
-	// Link resource views and sampler with variables within the shader
-	if(textured)
-	{
-		context->PSSetShaderResources(0, 1, &textureResourceView);
+	// No index buffer - nothing to draw
+	if(!indexBuffer)
+		return;
+
+	// Link sampler with variables within the shader - textures are linked per submesh
+	if(stripifier.isTextured())
 		context->PSSetSamplers(0, 1, &sampler);
-	}
 
 	// Set vertex layout
 	context->IASetInputLayout(inputLayout);
@@ -780,30 +484,31 @@ void DCStripification::render(ID3D11DeviceContext *context)
 	UINT vertexOffsets[] = {0};
 
 	context->IASetVertexBuffers(0, 1, vertexBuffers, vertexStrides, vertexOffsets);
-	context->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	context->IASetIndexBuffer(indexBuffer, packedIndices.format == DC_INDEX_16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
 
-	if(stripify)
-	{
-		// Set primitive topology for IA
+	// Set primitive topology for IA
+	if(stripifier.getSettings().stripify)
 		context->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+	else
+		context->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-		// Drawn index
-		unsigned int index = 0;
+	// Loop through and draw - one draw per strip, submesh or 16-bit chunk
+	for(unsigned int i = 0; i < packedIndices.draws.size(); ++i)
+	{
+		const DCIndexDraw& draw = packedIndices.draws[i];
 
-		// Loop through and draw all strips
-		for(stripsIt = strips.begin(); stripsIt != strips.end(); ++stripsIt)
+		// Submeshes are contiguous - bind each material's texture once
+		if(stripifier.isTextured() && (i == 0 || drawMaterials[i] != drawMaterials[i - 1]))
 		{
-			//stripsIt = strips.begin();
-			context->DrawIndexed((*stripsIt)->size() + 2, index, 0);
-			index += (*stripsIt)->size() + 2;
+			unsigned int material = drawMaterials[i];
+			ID3D11ShaderResourceView* texture = textureResourceView;
+
+			if(material < materialTextures.size() && materialTextures[material])
+				texture = materialTextures[material];
+
+			context->PSSetShaderResources(0, 1, &texture);
 		}
-	}
-	else
-	{
-		// Set primitive topology for IA
-		context->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST); //D3D10_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP
 
-		// Draw stripification model
-		context->DrawIndexed(model.getNumFaces() * 3, 0, 0);
+		context->DrawIndexed(draw.indexCount, draw.startIndex, draw.baseVertex);
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 // ----------------------------------------
 // Class:		DCEL stripification
-// Description:	Loads and stripifies a model
+// Description:	Loads and stripifies a model - Direct X
+//				adapter over DCStripifier
 // ----------------------------------------
 
 #pragma once
@@ -10,16 +11,13 @@
 // ----------------------------------------
 // INCLUDES
 // ----------------------------------------
-// STL
-#include <List>
-#include <vector>
-
 // Direct X
 #include <D3D11.h>
 
-// DCEL - Half-Edge
-#include <DCEL\Mesh.h>
-#include "DCMeshData.h" // Personalised mesh data
+// Device independent stripification
+#include "DCStripifier.h"
+#include "DCStripCache.h" // Stripified output saved between runs
+#include "DCAutotuner.h" // Tuned settings saved next to the model
 
 // CoreStructures
 #include <CoreStructures\CGTextureCoord.h>
@@ -31,15 +29,11 @@
 
 // ----------------------------------------
 
-// Structure for vertex duplication
-struct vDuplication
-{
-	unsigned int vertIndex;
-	unsigned int texIndex;
-};
+// Strip cache entries - one file per model and settings
+#define DC_CACHE_DIRECTORY L"Resources\\Cache\\"
 
-// Typedef for ease of use
-typedef Mesh<VertexData, HalfEdgeData, FaceData> DCMesh;
+// The index buffer holds 1 / DC_INDEX_HEADROOM more indices than built, for strips edits append
+#define DC_INDEX_HEADROOM 4
 
 // ----------------------------------------
 // CLASS INTERFACE DESIGN
@@ -49,68 +43,64 @@ class DCStripification : public CGBaseModel
 // ----------------------------------------
 private:
 	// Attributes -------------------------
-	// Model (DCEL)
-	DCMesh model;
+	// Stripifier - model, strips and output arrays
+	DCStripifier stripifier;
 
-	// Texture Coordinates
-	bool textured;
-	CoreStructures::CGTextureCoord* texCoords;
+	// Index buffer contents - width and draws with their base vertices
+	DCPackedIndices packedIndices;
+	std::vector<unsigned int> drawMaterials; // Material of each packed draw
+	unsigned int indexCapacity; // Indices the index buffer holds
+
+	// Stage timings and statistics - the stripifier's, with import and upload
+	DCStripReport report;
 
 	// Direct X and Shader variables
 	ID3D11ShaderResourceView	*textureResourceView;
 	ID3D11SamplerState			*sampler;
 
-	// List for vertex duplications
-	std::list<vDuplication> duplications;
-
-	// List of strips - stored as face indexes
-	std::list< std::vector<unsigned int>* > strips;
-	std::list< std::vector<unsigned int>* >::iterator stripsIt; // Iterator
-
-	// Stripification
-	bool stripify;
-
-	// Stripification settings
-	unsigned int maxLength;
+	// Material textures - by material id, NULL for the model texture
+	std::vector<ID3D11ShaderResourceView*> materialTextures;
 
 	// Methods ----------------------------
 	// Used for buffer setup
 	void setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode);
+	void setupIndexBuffer(ID3D11Device *device); // Packs the indices into a new index buffer
+	void setupDrawMaterials();
 
-	// Setup Index buffer
-	DWORD* setupIndexBuffer(ID3D11Device *device);
-	DWORD* setupStripification(ID3D11Device *device);
-
-	// Strip creation functions
-	void createStrip(DCMesh::Face* face);
-	DCMesh::Face* getFreeFace(); // Gets a free face with the lowest degree
-	DCMesh::Face* getNextFace(DCMesh::Face* face);
-	bool isTextureSeam(DCMesh::Face* face1, DCMesh::Face* face2);
-
-	// Index searching/creation
-	unsigned int otherVertex(DCMesh::Face* face1, DCMesh::Face* face2);
-	unsigned int commonVertex(DCMesh::Face* face1, DCMesh::Face* face2);
+	// Loads model data into a mesh definition
+	void loadModel(wchar_t* filename, DCMeshDef& meshDef);
 
-	// Loads model data into DCMesh
-	void loadModel(wchar_t* filename);
+	// Reads the model file bytes - the strip cache key
+	bool readModelFile(wchar_t* filename, std::vector<char>& bytes);
 
 	// Loads texture resource
 	void loadResources(ID3D11Device *device, wchar_t* filename);
 
-	// Duplication check
-	void checkDuplication(DCMesh::Vertex* vert, DCMesh::Face* face, unsigned int texIndex, int faceVertIndex);
+	// Shared constructor body - tuned settings saved next to the model replace the strip growth settings
+	void create(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, DCStripSettings settings, bool tuned);
 
 // ----------------------------------------
 public:
 
-	// Constructor / Destructor
-	DCStripification(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, bool stripify = 1);
+	// Constructor / Destructor - the first uses the model's tuning file if there is one
+	DCStripification(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, bool stripify = 1, DCStripOutput output = DC_OUTPUT_SEPARATE);
+	DCStripification(ID3D11Device *device, ID3DBlob *vsBytecode, wchar_t* modelFilename, wchar_t* textureFilename, const DCStripSettings& settings);
 	~DCStripification();
 
-	// Render
+	// Loads the texture bound for one material's submesh
+	void loadMaterialTexture(ID3D11Device *device, unsigned int material, wchar_t* filename);
+
+	// Applies an edit - only the index ranges it patched are uploaded, unless the
+	// indices outgrow the buffer or need packing again
+	void editMesh(ID3D11Device *device, ID3D11DeviceContext *context, const DCMeshEdit& edit);
+
+	// Render - state changes once per submesh
 	void render(ID3D11DeviceContext *context);
 
+	// Getters
+	const DCStripReport& getReport() const;
+
 };
 // ----------------------------------------
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,2705 @@
+// ----------------------------------------
+// Class: DCEL Stripifier source
+// ----------------------------------------
+
+// Include header
+#include "DCStripifier.h"
+#include "DCStripBuilder.h"
+#include "DCStripTree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "DCCacheMetrics.h"
+#include "DCOverdraw.h"
+
+// Ensure correct namespace use
+using namespace std;
+
+// Wall clock seconds since start
+static double secondsSince(chrono::high_resolution_clock::time_point start)
+{
+	return chrono::duration_cast< chrono::duration<double> >(chrono::high_resolution_clock::now() - start).count();
+}
+
+// Material order of faces - sorts keep file or strip order within a material
+struct DCMaterialOrder
+{
+	const DCMesh* model;
+
+	DCMaterialOrder(const DCMesh& model) : model(&model)
+	{
+	}
+
+	unsigned int material(unsigned int face) const
+	{
+		return model->getFace(face)->getData().material;
+	}
+
+	bool operator()(unsigned int face1, unsigned int face2) const
+	{
+		return material(face1) < material(face2);
+	}
+
+};
+
+// Material order of strips by their first face
+struct DCStripMaterialOrder
+{
+	DCMaterialOrder faces;
+	const DCStripList* strips;
+
+	DCStripMaterialOrder(const DCMesh& model, const DCStripList& strips) : faces(model), strips(&strips)
+	{
+	}
+
+	bool operator()(unsigned int strip1, unsigned int strip2) const
+	{
+		return faces(strips->getFaces(strip1)[0], strips->getFaces(strip2)[0]);
+	}
+};
+
+// Index order of strip spans
+struct DCSpanOrder
+{
+	const std::vector<DCStripSpan>* spans;
+
+	DCSpanOrder(const std::vector<DCStripSpan>& spans) : spans(&spans)
+	{
+	}
+
+	bool operator()(unsigned int span1, unsigned int span2) const
+	{
+		return (*spans)[span1].range.start < (*spans)[span2].range.start;
+	}
+};
+
+// Index order of ranges
+static bool isRangeBefore(const DCIndexRange& range1, const DCIndexRange& range2)
+{
+	return range1.start < range2.start;
+}
+
+// Merge ranges - sorted, with overlapping and touching ranges joined
+static void mergeRanges(std::vector<DCIndexRange>& ranges)
+{
+	std::sort(ranges.begin(), ranges.end(), isRangeBefore);
+
+	unsigned int numMerged = 0;
+
+	for(unsigned int i = 0; i < ranges.size(); ++i)
+	{
+		DCIndexRange* last = numMerged ? &ranges[numMerged - 1] : NULL;
+
+		if(last && ranges[i].start <= last->start + last->count)
+			last->count = std::max(last->start + last->count, ranges[i].start + ranges[i].count) - last->start;
+		else
+			ranges[numMerged++] = ranges[i];
+	}
+
+	ranges.resize(numMerged);
+}
+
+// Strips in material order - strip ids, keeping list order within a material
+static void sortByMaterial(const DCMesh& model, const DCStripList& strips, std::vector<unsigned int>& order)
+{
+	order.resize(strips.size());
+
+	for(unsigned int i = 0; i < order.size(); ++i)
+		order[i] = i;
+
+	std::stable_sort(order.begin(), order.end(), DCStripMaterialOrder(model, strips));
+}
+
+// ----------------------------------------
+// Settings
+// ----------------------------------------
+
+// Constructor - default settings
+DCStripSettings::DCStripSettings()
+{
+	stripify = true;
+	output = DC_OUTPUT_SEPARATE;
+	useTextures = true;
+	maxLength = 500;
+	indexFormat = DC_INDEX_16;
+	reorderVertices = true;
+
+	strategy = DC_STRATEGY_GREEDY;
+	cacheType = DC_CACHE_FIFO;
+	cacheSize = 16;
+	lookAhead = 2;
+
+	tunnelIterations = 0;
+	tunnelDepth = 16;
+
+	threads = 1;
+
+	seedRuns = 1;
+	seedScore = DC_SEED_SCORE_STRIPS;
+
+	orderOverdraw = false;
+	overdrawThreshold = 1.05f;
+}
+
+// Constructor - build over every face
+DCStripBuild::DCStripBuild()
+{
+	region = DC_NO_REGION;
+}
+
+// ----------------------------------------
+// Stripifier
+// ----------------------------------------
+
+// Constructor
+DCStripifier::DCStripifier(const DCStripSettings& settings)
+{
+	this->settings = settings;
+	stripGrowth = NULL;
+	textured = false;
+	joinIndices = 0;
+	swaps = 0;
+	tunnelSearch = 0;
+	untunnelledStrips = 0;
+	regionCuts = 0;
+	largestRegion = 0;
+	tailSpan = DC_NO_FACE;
+}
+
+// Destructor
+DCStripifier::~DCStripifier()
+{
+	// Clean memory
+	duplications.clear();
+	duplicationIds.clear();
+}
+
+// Load Mesh
+void DCStripifier::loadMesh(const DCMeshDef& meshDef)
+{
+	unsigned int numVertices = meshDef.positions.size() / 3;
+	unsigned int numFaces = meshDef.faceVertices.size() / 3;
+
+	// DEBUG
+	cerr << "Reserving memory for: " << endl;
+	cerr << numVertices << " vertices;" << endl;
+	cerr << numFaces << " faces;" << endl;
+	cerr << (2 * (3 * numFaces)) << " half-edges." << endl;
+
+	// Clear previous results
+	report = DCStripReport();
+	strips.clear();
+	duplications.clear();
+	duplicationIds.clear();
+	vertices.clear();
+	indices.clear();
+	drawCounts.clear();
+	submeshes.clear();
+	faceRegions.clear();
+	stripSpans.clear();
+	faceSpans.clear();
+	holeSpans.clear();
+	patchedRanges.clear();
+
+	// Clear model data and reserve space
+	model.clear();
+	model.getVertices().reserve(numVertices);
+	model.getFaces().reserve(numFaces);
+	model.getHalfEdges().reserve(2 * (3 * numFaces));
+
+	// DEBUG
+	cerr << "Populating DCEL structure..." << endl;
+	cerr << "Populating vertices..." << endl;
+
+	// 1. Fill the DCEL with the mesh data
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	// Create vertices
+	for(unsigned int i = 0; i < numVertices; ++i)
+	{
+		// Create new vertex
+		DCMesh::Vertex* vert = model.createGetVertex();
+
+		// Set data - position and normals
+		vert->getData().setPosition(Vector3f(meshDef.positions[i * 3], meshDef.positions[i * 3 + 1], meshDef.positions[i * 3 + 2]));
+
+		if(meshDef.normals.size() >= (i + 1) * 3)
+			vert->getData().setNormal(Vector3f(meshDef.normals[i * 3], meshDef.normals[i * 3 + 1], meshDef.normals[i * 3 + 2]));
+	}
+
+	// Output ids start in file order - duplicates follow
+	vertexIds.resize(numVertices);
+
+	for(unsigned int i = 0; i < numVertices; ++i)
+		vertexIds[i] = i;
+
+	// Check for texture coordinates
+	textured = settings.useTextures && !meshDef.texCoords.empty() && meshDef.faceTexCoords.size() == meshDef.faceVertices.size();
+
+	if(textured)
+		texCoords = meshDef.texCoords;
+	else
+		texCoords.clear();
+
+	// DEBUG
+	cerr << "Populating faces..." << endl;
+
+	// Create faces - triangular
+	for(unsigned int i = 0; i < numFaces; ++i)
+		model.createTriangularFace(meshDef.faceVertices[i * 3], meshDef.faceVertices[i * 3 + 1], meshDef.faceVertices[i * 3 + 2]);
+
+	report.dcelTime = secondsSince(start);
+	start = chrono::high_resolution_clock::now();
+
+	// Check faces & Manage unhandled
+	model.checkAllFaces();
+	model.manageUnhandledTriangles();
+
+	report.checkFacesTime = secondsSince(start);
+	start = chrono::high_resolution_clock::now();
+
+	// 2. Setup faces
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	{
+		// Create new face
+		DCMesh::Face* face = model.getFace(i);
+		const unsigned int* fv = &meshDef.faceVertices[i * 3];
+
+		// Per-face indices
+		face->getData().setIndices(fv[0], fv[1], fv[2]);
+		face->getData().hidden = i < meshDef.hiddenFaces.size() && meshDef.hiddenFaces[i];
+		face->getData().material = i < meshDef.faceMaterials.size() ? meshDef.faceMaterials[i] : 0;
+
+		// Duplicate faces are not needed if there are no texture coordinates
+		if(textured)
+		{
+			const unsigned int* ft = &meshDef.faceTexCoords[i * 3];
+
+			// Per-face texture coordinates
+			face->getData().setTexIndices(ft[0], ft[1], ft[2]);
+
+			// Check for vertex duplications - texture coordinate seams
+			checkDuplication(model.getVertex(fv[0]), face, ft[0], 0);
+			checkDuplication(model.getVertex(fv[1]), face, ft[1], 1);
+			checkDuplication(model.getVertex(fv[2]), face, ft[2], 2);
+		}
+	}
+
+	// DEBUG
+	cerr << duplications.size() << " duplicated vertices." << endl;
+	cerr << model.getNumHalfEdges() << " half-edges created." << endl;
+
+	// Peak before the half-edges are trimmed
+	sampleMemory();
+
+	// Resize half-edge vector to save memory
+	model.getHalfEdges().resize(model.getNumHalfEdges());
+
+	report.duplicationTime = secondsSince(start);
+	start = chrono::high_resolution_clock::now();
+
+	cerr << "Linking faces... " << endl;
+
+	// 3. Loop through faces - alter degree
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	{
+		// Create edge iterator
+		EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(model.getFace(i));
+
+		// Check neighbours
+		for(int j = 0; j < 3; ++j)
+			edgeIt.getNext()->getFace()->getData().degree += 1; // Add to number of neighbours
+	}
+
+	// 4. Flatten the neighbours of each face
+	setupAdjacency(meshDef);
+
+	report.degreeTime = secondsSince(start);
+	sampleMemory();
+
+	cerr << "Done!" << endl;
+}
+
+// Build - vertex array then indices
+void DCStripifier::build()
+{
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	report.stripTime = 0;
+
+	setupVertices();
+
+	// Setup indexes based on stripification setting
+	if(settings.stripify)
+		setupStripification(); // Stripification
+	else
+		setupIndexBuffer(); // Normal setup
+
+	// Single draw output
+	if(settings.stripify && settings.output == DC_OUTPUT_RESTART)
+		joinRestart();
+	else if(settings.stripify && settings.output == DC_OUTPUT_STITCHED)
+		joinStitched();
+
+	// Vertex fetch order
+	report.fetchLinesBefore = 0;
+	report.fetchLinesAfter = 0;
+	report.fetchDistanceBefore = 0;
+	report.fetchDistanceAfter = 0;
+
+	if(settings.reorderVertices)
+		reorderOutputVertices();
+
+	// Emission is everything but strip growth
+	report.emitTime = secondsSince(start) - report.stripTime;
+	fillReport();
+}
+
+// Reorder output vertices - number vertices as the index stream first uses them; unused
+// vertices follow in their old order. Faces and duplications are remapped to match.
+// Fetch scatter is measured either side for the report
+void DCStripifier::reorderOutputVertices()
+{
+	DCCacheReport fetch = DCCacheMetrics::measure(indices, drawCounts, settings.stripify, settings.cacheType, settings.cacheSize);
+
+	report.fetchLinesBefore = fetch.fetchLines;
+	report.fetchDistanceBefore = fetch.fetchDistance;
+
+	std::vector<unsigned int> newIds(vertices.size(), DC_NO_FACE);
+	unsigned int next = 0;
+
+	for(unsigned int i = 0; i < indices.size(); ++i)
+	{
+		if(settings.stripify && indices[i] == DC_STRIP_CUT_32)
+			continue;
+
+		if(newIds[indices[i]] == DC_NO_FACE)
+			newIds[indices[i]] = next++;
+	}
+
+	for(unsigned int i = 0; i < newIds.size(); ++i)
+		if(newIds[i] == DC_NO_FACE)
+			newIds[i] = next++;
+
+	// Vertices
+	std::vector<DCStripVertex> reordered(vertices.size());
+
+	for(unsigned int i = 0; i < vertices.size(); ++i)
+		reordered[newIds[i]] = vertices[i];
+
+	vertices.swap(reordered);
+
+	// Indices
+	for(unsigned int i = 0; i < indices.size(); ++i)
+		if(!(settings.stripify && indices[i] == DC_STRIP_CUT_32))
+			indices[i] = newIds[indices[i]];
+
+	// Faces, DCEL vertices and duplications
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+		for(int j = 0; j < 3; ++j)
+			model.getFace(i)->getData().v[j] = newIds[model.getFace(i)->getData().v[j]];
+
+	for(unsigned int i = 0; i < vertexIds.size(); ++i)
+		vertexIds[i] = newIds[vertexIds[i]];
+
+	for(unsigned int i = 0; i < duplications.size(); ++i)
+		duplications[i].index = newIds[duplications[i].index];
+
+	fetch = DCCacheMetrics::measure(indices, drawCounts, settings.stripify, settings.cacheType, settings.cacheSize);
+
+	report.fetchLinesAfter = fetch.fetchLines;
+	report.fetchDistanceAfter = fetch.fetchDistance;
+}
+
+// Setup vertex array - original vertices followed by duplications
+void DCStripifier::setupVertices()
+{
+	vertices.resize(model.getNumVertices() + duplications.size());
+
+	// Setup vertex array
+	for(unsigned int i = 0; i < model.getNumVertices(); ++i)
+	{
+		// Get vertex
+		DCMesh::Vertex* vert = model.getVertex(i);
+
+		DCStripVertex& vertex = vertices[vertexIds[i]];
+
+		// Set position data
+		vertex.pos[0] = vert->getData().position.x;
+		vertex.pos[1] = vert->getData().position.y;
+		vertex.pos[2] = vert->getData().position.z;
+
+		// Set normal data
+		vertex.normal[0] = vert->getData().normal.x;
+		vertex.normal[1] = vert->getData().normal.y;
+		vertex.normal[2] = vert->getData().normal.z;
+
+		vertex.texCoord[0] = 0;
+		vertex.texCoord[1] = 0;
+	}
+
+	// Create vertex duplications
+	for(unsigned int i = 0; i < duplications.size(); ++i)
+	{
+		// Copy the original vertex
+		vertices[duplications[i].index] = vertices[vertexIds[duplications[i].vertIndex]];
+	}
+
+	// Setup texture coordinates
+	if(textured)
+	{
+		for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+		{
+			// Get face
+			DCMesh::Face* face = model.getFace(i);
+
+			for(unsigned int j = 0; j < 3; ++j)
+			{
+				vertices[face->getData().v[j]].texCoord[0] = texCoords[face->getData().t[j] * 2];
+				vertices[face->getData().v[j]].texCoord[1] = texCoords[face->getData().t[j] * 2 + 1];
+			}
+		}
+	}
+}
+
+// Setup index buffer - Standard: No stripification
+void DCStripifier::setupIndexBuffer()
+{
+	indices.clear();
+	indices.reserve(model.getNumFaces() * 3);
+	drawCounts.clear();
+	submeshes.clear();
+	stripSpans.clear();
+
+	joinIndices = 0;
+	swaps = 0;
+
+	// Visible faces in material order
+	std::vector<unsigned int> faces;
+	faces.reserve(model.getNumFaces());
+
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+		if(!model.getFace(i)->getData().hidden)
+			faces.push_back(i);
+
+	std::stable_sort(faces.begin(), faces.end(), DCMaterialOrder(model));
+
+	// Setup index array - one draw per material
+	for(unsigned int i = 0; i < faces.size(); ++i)
+	{
+		const FaceData& face = model.getFace(faces[i])->getData();
+
+		if(submeshes.empty() || submeshes.back().material != face.material)
+		{
+			beginSubmesh(face.material);
+			drawCounts.push_back(0);
+			submeshes.back().numDraws = 1;
+		}
+
+		for(unsigned int j = 0; j < 3; ++j)
+			indices.push_back(face.v[j]);
+
+		submeshes.back().range.count += 3;
+		drawCounts.back() += 3;
+	}
+}
+
+// Begin submesh - at the end of the index stream, with no draws yet
+void DCStripifier::beginSubmesh(unsigned int material)
+{
+	DCSubmesh submesh;
+	submesh.material = material;
+	submesh.range.start = indices.size();
+	submesh.range.count = 0;
+	submesh.firstDraw = drawCounts.size();
+	submesh.numDraws = 0;
+
+	submeshes.push_back(submesh);
+}
+
+// Group strips - by material, keeping their order within a material
+void DCStripifier::groupStrips()
+{
+	std::vector<unsigned int> order;
+	sortByMaterial(model, strips, order);
+
+	strips.reorder(order);
+}
+
+// Setup index buffer - Stripified
+void DCStripifier::setupStripification()
+{
+	// Index buffer for stripification
+	indices.clear();
+	drawCounts.clear();
+	submeshes.clear();
+	joinIndices = 0;
+	swaps = 0;
+	strips.clear();
+	resetFaces();
+
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	cerr << "Stripifiying Mesh..." << endl;
+
+	// Cache strategy setup - shared by every build; other builders may seed from the cache too
+	if(settings.strategy == DC_STRATEGY_CACHE || stripGrowth)
+		setupVertexFaces();
+
+	// One build per region - regions are grown on their own threads
+	unsigned int numRegions = settings.threads > 1 ? settings.threads : 1;
+
+	// Seed runs grow every face - no regions
+	if(settings.seedRuns > 1)
+		numRegions = 1;
+
+	faceRegions.clear();
+	regionCuts = 0;
+	largestRegion = 0;
+
+	if(numRegions > 1)
+		partitionFaces(numRegions);
+
+	std::vector<DCStripBuild> builds(numRegions);
+
+	for(unsigned int i = 0; i < numRegions; ++i)
+		builds[i].region = numRegions > 1 ? i : DC_NO_REGION;
+
+	if(settings.seedRuns > 1)
+		growSeedRuns(builds[0]);
+	else if(numRegions > 1)
+	{
+		std::vector<std::thread> workers;
+
+		for(unsigned int i = 0; i < numRegions; ++i)
+			workers.push_back(std::thread(&DCStripifier::growStrips, this, std::ref(builds[i])));
+
+		for(unsigned int i = 0; i < numRegions; ++i)
+			workers[i].join();
+
+		cerr << numRegions << " regions, " << regionCuts << " edges cut, largest " << largestRegion << " faces." << endl;
+	}
+	else
+		growStrips(builds[0]);
+
+	// Strips in region order - the same output for a given thread count
+	unsigned long long queueBytes = 0;
+
+	strips.reserve(model.getNumFaces());
+
+	for(unsigned int i = 0; i < numRegions; ++i)
+	{
+		strips.append(builds[i].strips);
+		queueBytes += builds[i].freeFaces.getBytes() + builds[i].faces.capacity() * sizeof(DCFaceState);
+	}
+
+	report.sampleMemory("faceQueues", queueBytes);
+
+	cerr << strips.size() << " strips created." << endl;
+
+	// Merge strips along tunnels
+	untunnelledStrips = strips.size();
+
+	if(settings.tunnelIterations)
+	{
+		tunnelStrips();
+		cerr << strips.size() << " strips after tunnelling." << endl;
+	}
+
+	// Draw outward facing strips first
+	if(settings.orderOverdraw)
+		orderStrips();
+
+	// One submesh per material
+	groupStrips();
+
+	sampleMemory();
+	report.stripTime = secondsSince(start);
+
+	// 3. Setup strip index buffer
+	emitStrips();
+}
+
+// Emit strips - at most two indices per face and one per strip, a swap on every inner
+// face. Strips are grouped by material - each group is a submesh
+void DCStripifier::emitStrips()
+{
+	indices.clear();
+	drawCounts.clear();
+	submeshes.clear();
+	swaps = 0;
+
+	stripSpans.clear();
+	stripSpans.reserve(strips.size());
+	indices.reserve(strips.getNumFaces() * 2 + strips.size());
+
+	for(unsigned int i = 0; i < strips.size(); ++i)
+	{
+		const unsigned int* strip = strips.getFaces(i);
+		unsigned int material = model.getFace(strip[0])->getData().material;
+
+		if(submeshes.empty() || submeshes.back().material != material)
+			beginSubmesh(material);
+
+		DCStripSpan span;
+		span.numFaces = strips.getNumFaces(i);
+		span.range.start = indices.size();
+
+		swaps += emitStrip(strip, span.numFaces, indices);
+
+		// Record draw count - the strip's indices as emitted
+		span.range.count = indices.size() - span.range.start;
+		drawCounts.push_back(span.range.count);
+		stripSpans.push_back(span);
+
+		submeshes.back().range.count += span.range.count;
+		submeshes.back().numDraws += 1;
+	}
+
+	setupEdits();
+}
+
+// Emit strip - the strip's indices from its standalone vertex, with a swap
+// wherever the next face does not follow the strip's winding
+unsigned int DCStripifier::emitStrip(const unsigned int* strip, unsigned int numFaces, std::vector<unsigned int>& indexVec)
+{
+	unsigned int swapCount = 0;
+
+	// Slot of the edge each face was entered through - consecutive strip faces are neighbours
+	unsigned int inSlot = 0;
+
+	// Loop through each of the faces in the strip and add the indices
+	for(unsigned int i = 0; i < numFaces; ++i)
+	{
+		unsigned int face = strip[i];
+
+		// Slot of the edge to the next face
+		unsigned int outSlot = 0;
+
+		if(i + 1 < numFaces)
+			outSlot = findSlot(face, strip[i + 1]);
+
+		// 1. Add verticies to the strip - from stand alone vertex
+		if(i == 0)
+		{
+			const unsigned int* v = model.getFace(face)->getData().v;
+
+			// Check for single triangle strip
+			if(numFaces > 1)
+			{
+				// The standalone is the vertex off the edge to the next face
+				unsigned int j = adjacency[face].opposite[outSlot];
+
+				indexVec.push_back(v[j]);
+				indexVec.push_back(v[(j + 1) % 3]);
+				indexVec.push_back(v[(j + 2) % 3]);
+			}
+			else
+			{
+				for(int k = 0; k < 3; ++k)
+					indexVec.push_back(v[k]);
+			}
+		}
+		// 2. Increment i, adding the next triangle
+		else
+		{
+			// 3. Consider the existance of i + 1
+			if(i == numFaces - 1)
+				// If no, add the other vertex of i
+				indexVec.push_back(otherVertex(face, inSlot));
+			// If yes, find the common vertex between i - 1 and i + 1
+			else
+			{
+				// Find common vertex in i - 1 and i + 1
+				unsigned int common = commonVertex(face, inSlot, outSlot);
+
+				// If the common vertex is the 'tail' of the strip, add the 'other vertex'
+				if(indexVec.back() == common)
+					indexVec.push_back(otherVertex(face, inSlot));
+				// If not, add the common vertex to the strip (swap), then add the 'other vertex'
+				else
+				{
+					indexVec.push_back(common);
+					indexVec.push_back(otherVertex(face, inSlot));
+
+					// A swap has occured - increment count
+					++swapCount;
+				}
+			}
+		}
+
+		// The next face is entered through the same edge
+		inSlot = adjacency[face].slots[outSlot];
+	}
+
+	return swapCount;
+}
+
+// Setup adjacency - neighbours in half-edge order, the shared edge's slot in
+// each neighbour, the vertex off each edge and the texture seams
+void DCStripifier::setupAdjacency(const DCMeshDef& meshDef)
+{
+	unsigned int numFaces = model.getNumFaces();
+
+	adjacency.resize(numFaces);
+
+	for(unsigned int i = 0; i < numFaces; ++i)
+	{
+		DCMesh::Face* face = model.getFace(i);
+		DCFaceAdjacency& adjacent = adjacency[i];
+		EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(face);
+
+		adjacent.seams = 0;
+
+		for(unsigned int j = 0; j < 3; ++j)
+		{
+			DCMesh::HalfEdge* edge = edgeIt.getNext();
+			DCMesh::Face* neighbour = edge->getTwin()->getFace();
+
+			// Vertex off the edge - found in file order, before seam duplication
+			unsigned int opposite = model.getVertexId(edge->getNext()->getNext()->getOrigin());
+
+			adjacent.opposite[j] = 0;
+
+			for(unsigned int k = 0; k < 3; ++k)
+				if(meshDef.faceVertices[i * 3 + k] == opposite)
+					adjacent.opposite[j] = k;
+
+			adjacent.neighbours[j] = DC_NO_FACE;
+
+			if(!neighbour)
+				continue;
+
+			adjacent.neighbours[j] = model.getFaceId(neighbour);
+
+			if(isTextureSeam(face, neighbour) || face->getData().material != neighbour->getData().material)
+				adjacent.seams |= 1 << j;
+		}
+	}
+
+	// Slots of the shared edges - from the neighbours' entries
+	for(unsigned int i = 0; i < numFaces; ++i)
+		for(unsigned int j = 0; j < 3; ++j)
+			adjacency[i].slots[j] = adjacency[i].neighbours[j] == DC_NO_FACE ? 0 : findSlot(adjacency[i].neighbours[j], i);
+}
+
+// Reset faces - every visible face free; degree counts the face's edges as loadMesh does
+void DCStripifier::resetFaces()
+{
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	{
+		model.getFace(i)->getData().free = !model.getFace(i)->getData().hidden;
+		model.getFace(i)->getData().degree = 3;
+	}
+}
+
+// Setup edits - the strip of each face, and the edit build's queue over every face id
+void DCStripifier::setupEdits()
+{
+	unsigned int numFaces = model.getNumFaces();
+
+	faceSpans.assign(numFaces, DC_NO_FACE);
+
+	for(unsigned int i = 0; i < stripSpans.size(); ++i)
+		for(unsigned int j = 0; j < stripSpans[i].numFaces; ++j)
+			faceSpans[strips.getFaces(i)[j]] = i;
+
+	// Edits mark the faces they regrow with their own region
+	if(faceRegions.empty())
+		faceRegions.assign(numFaces, DC_NO_REGION);
+
+	// No holes yet - the last strip ends the index stream
+	holeSpans.clear();
+	tailSpan = stripSpans.empty() ? DC_NO_FACE : stripSpans.size() - 1;
+
+	editBuild.region = DC_EDIT_REGION;
+	editBuild.faces.resize(numFaces);
+	editBuild.freeFaces.setup(numFaces, 3);
+	editBuild.strips.clear();
+}
+
+// Join restart - one index stream with a strip cut between strips
+void DCStripifier::joinRestart()
+{
+	std::vector<unsigned int> joined;
+	joined.reserve(indices.size() + drawCounts.size());
+
+	std::vector<unsigned int> joinedCounts;
+	unsigned int start = 0;
+
+	for(unsigned int s = 0; s < submeshes.size(); ++s)
+	{
+		DCSubmesh& submesh = submeshes[s];
+		submesh.range.start = joined.size();
+
+		for(unsigned int i = submesh.firstDraw; i < submesh.firstDraw + submesh.numDraws; ++i)
+		{
+			// Each strip's range holds the cut before it
+			stripSpans[i].range.start = joined.size();
+
+			if(i > submesh.firstDraw)
+				joined.push_back(DC_STRIP_CUT_32);
+
+			joined.insert(joined.end(), indices.begin() + start, indices.begin() + start + drawCounts[i]);
+			start += drawCounts[i];
+
+			stripSpans[i].range.count = joined.size() - stripSpans[i].range.start;
+		}
+
+		// One draw per submesh
+		submesh.range.count = joined.size() - submesh.range.start;
+		submesh.firstDraw = s;
+		submesh.numDraws = 1;
+
+		joinedCounts.push_back(submesh.range.count);
+	}
+
+	joinIndices = joined.size() - indices.size();
+
+	indices.swap(joined);
+	drawCounts.swap(joinedCounts);
+}
+
+// Join stitched - repeat the last index of a strip and the first of the next
+void DCStripifier::joinStitched()
+{
+	std::vector<unsigned int> joined;
+	joined.reserve(indices.size() + drawCounts.size() * 3);
+
+	std::vector<unsigned int> joinedCounts;
+	unsigned int start = 0;
+
+	for(unsigned int s = 0; s < submeshes.size(); ++s)
+	{
+		DCSubmesh& submesh = submeshes[s];
+		submesh.range.start = joined.size();
+
+		for(unsigned int i = submesh.firstDraw; i < submesh.firstDraw + submesh.numDraws; ++i)
+		{
+			if(i > submesh.firstDraw && drawCounts[i])
+			{
+				unsigned int first = indices[start];
+
+				// Each strip's range ends on its repeated last index and starts on its
+				// repeated first index, so a range refilled with one index stays degenerate
+				joined.push_back(joined.back());
+				stripSpans[i - 1].range.count += 1;
+				stripSpans[i].range.start = joined.size();
+
+				joined.push_back(first);
+
+				// Strips must start on an even index of the draw to keep their winding
+				if((joined.size() - submesh.range.start) % 2)
+					joined.push_back(first);
+			}
+			else
+				stripSpans[i].range.start = joined.size();
+
+			joined.insert(joined.end(), indices.begin() + start, indices.begin() + start + drawCounts[i]);
+			start += drawCounts[i];
+
+			stripSpans[i].range.count = joined.size() - stripSpans[i].range.start;
+		}
+
+		// One draw per submesh
+		submesh.range.count = joined.size() - submesh.range.start;
+		submesh.firstDraw = s;
+		submesh.numDraws = 1;
+
+		joinedCounts.push_back(submesh.range.count);
+	}
+
+	joinIndices = joined.size() - indices.size();
+
+	indices.swap(joined);
+	drawCounts.swap(joinedCounts);
+}
+
+// Edit mesh - strips touching an edited face are released and their faces regrown
+// with any shown faces as one region; the work follows the size of the edit
+void DCStripifier::editMesh(const DCMeshEdit& edit)
+{
+	unsigned int numFaces = model.getNumFaces();
+	std::vector<unsigned int> faces; // Faces to regrow
+
+	patchedRanges.clear();
+
+	// Restored output has no model to edit
+	if(!numFaces)
+		return;
+
+	// No strips to patch - faces are hidden and shown for the next build, lists are rebuilt
+	if(!settings.stripify || faceSpans.size() != numFaces)
+	{
+		for(unsigned int i = 0; i < edit.removed.size(); ++i)
+			if(edit.removed[i] < numFaces)
+				model.getFace(edit.removed[i])->getData().hidden = 1;
+
+		for(unsigned int i = 0; i < edit.added.size(); ++i)
+			if(edit.added[i] < numFaces)
+				model.getFace(edit.added[i])->getData().hidden = 0;
+
+		if(!settings.stripify && !indices.empty())
+		{
+			setupIndexBuffer();
+
+			DCIndexRange range;
+			range.start = 0;
+			range.count = indices.size();
+
+			patchedRanges.push_back(range);
+		}
+
+		return;
+	}
+
+	// Hide removed faces - the rest of their strips is regrown
+	for(unsigned int i = 0; i < edit.removed.size(); ++i)
+	{
+		unsigned int faceId = edit.removed[i];
+
+		if(faceId >= numFaces || model.getFace(faceId)->getData().hidden)
+			continue;
+
+		model.getFace(faceId)->getData().hidden = 1;
+		model.getFace(faceId)->getData().free = 0;
+		releaseStrip(faceSpans[faceId], faces);
+	}
+
+	for(unsigned int i = 0; i < edit.modified.size(); ++i)
+		if(edit.modified[i] < numFaces)
+			releaseStrip(faceSpans[edit.modified[i]], faces);
+
+	// Show added faces - with their neighbours' strips, so they can join them
+	for(unsigned int i = 0; i < edit.added.size(); ++i)
+	{
+		unsigned int faceId = edit.added[i];
+
+		if(faceId >= numFaces || !model.getFace(faceId)->getData().hidden)
+			continue;
+
+		model.getFace(faceId)->getData().hidden = 0;
+		faces.push_back(faceId);
+
+		for(int j = 0; j < 3; ++j)
+		{
+			unsigned int neighbour = adjacency[faceId].neighbours[j];
+
+			if(neighbour != DC_NO_FACE && !model.getFace(neighbour)->getData().hidden)
+				releaseStrip(faceSpans[neighbour], faces);
+		}
+	}
+
+	// Free the visible faces into the edit region
+	unsigned int numRegrown = 0;
+
+	for(unsigned int i = 0; i < faces.size(); ++i)
+	{
+		DCMesh::Face* face = model.getFace(faces[i]);
+
+		if(face->getData().hidden || faceRegions[faces[i]] == DC_EDIT_REGION)
+			continue;
+
+		faceRegions[faces[i]] = DC_EDIT_REGION;
+		editBuild.faces[faces[i]].free = true;
+		faces[numRegrown++] = faces[i];
+	}
+
+	faces.resize(numRegrown);
+
+	// Queue by free neighbours
+	for(unsigned int i = 0; i < faces.size(); ++i)
+	{
+		DCFaceState& state = editBuild.faces[faces[i]];
+
+		state.degree = 0;
+
+		for(int j = 0; j < 3; ++j)
+		{
+			unsigned int neighbour = adjacency[faces[i]].neighbours[j];
+
+			if(neighbour != DC_NO_FACE && isInRegion(editBuild, neighbour))
+				state.degree += 1;
+		}
+
+		editBuild.freeFaces.push(faces[i], state.degree);
+	}
+
+	editBuild.strips.reserve(faces.size());
+
+	stripFreeFaces(editBuild);
+
+	for(unsigned int i = 0; i < faces.size(); ++i)
+		faceRegions[faces[i]] = DC_NO_REGION;
+
+	// New strips into holes of their material, or after the last strip - in material
+	// order, so each material adds at most one submesh
+	unsigned int numReleased = patchedRanges.size();
+	unsigned int numGrown = editBuild.strips.size();
+	unsigned int numPlaced = 0;
+
+	std::vector<unsigned int> order;
+	sortByMaterial(model, editBuild.strips, order);
+
+	// Strips of the last submesh's material first - they join it
+	if(!submeshes.empty())
+	{
+		std::vector<unsigned int> joining;
+		std::vector<unsigned int> others;
+
+		for(unsigned int i = 0; i < order.size(); ++i)
+		{
+			if(model.getFace(editBuild.strips.getFaces(order[i])[0])->getData().material == submeshes.back().material)
+				joining.push_back(order[i]);
+			else
+				others.push_back(order[i]);
+		}
+
+		joining.insert(joining.end(), others.begin(), others.end());
+		order.swap(joining);
+	}
+
+	DCIndexRange tail;
+	tail.start = indices.size();
+
+	std::vector<unsigned int> stripIndices;
+
+	for(unsigned int i = 0; i < order.size(); ++i)
+	{
+		const unsigned int* strip = editBuild.strips.getFaces(order[i]);
+		unsigned int numStripFaces = editBuild.strips.getNumFaces(order[i]);
+
+		stripIndices.clear();
+		swaps += emitStrip(strip, numStripFaces, stripIndices);
+
+		if(placeStrip(strip, numStripFaces, stripIndices))
+			++numPlaced;
+		else
+			appendStrip(strip, numStripFaces, stripIndices);
+	}
+
+	editBuild.strips.clear();
+
+	tail.count = indices.size() - tail.start;
+
+	if(tail.count)
+		patchedRanges.push_back(tail);
+
+	// Holes of each submesh - past their share every strip is emitted again, as it is
+	// once appended strips have split the materials over twice as many submeshes
+	std::vector<unsigned int> holes(submeshes.size(), 0);
+	std::vector<bool> materials;
+
+	for(unsigned int i = 0; i < submeshes.size(); ++i)
+	{
+		if(submeshes[i].material >= materials.size())
+			materials.resize(submeshes[i].material + 1, false);
+
+		materials[submeshes[i].material] = true;
+	}
+
+	bool compact = submeshes.size() > 2 * (unsigned int)std::count(materials.begin(), materials.end(), true);
+
+	for(unsigned int i = 0; i < holeSpans.size(); ++i)
+	{
+		const DCIndexRange& range = stripSpans[holeSpans[i]].range;
+		unsigned int submesh = findSubmesh(range.start);
+
+		holes[submesh] += range.count;
+
+		if(holes[submesh] * DC_EDIT_HOLE_SHARE > submeshes[submesh].range.count)
+			compact = true;
+	}
+
+	if(compact)
+		compactStrips();
+	else
+		mergeRanges(patchedRanges);
+
+	unsigned int numPatched = 0;
+
+	for(unsigned int i = 0; i < patchedRanges.size(); ++i)
+		numPatched += patchedRanges[i].count;
+
+	cerr << numReleased << " strips replaced by " << numGrown << " (" << numPlaced << " into holes), " << numPatched << " indices patched"
+		<< (compact ? ", compacted." : ".") << endl;
+}
+
+// Release strip - its faces are collected for regrowing and its index range left as a
+// hole of strip cuts, or of one repeated index so every triangle over it is degenerate
+void DCStripifier::releaseStrip(unsigned int span, std::vector<unsigned int>& faces)
+{
+	if(span == DC_NO_FACE || !stripSpans[span].numFaces)
+		return;
+
+	// The strip's faces stay in the strip list - its span marks it replaced
+	const unsigned int* strip = strips.getFaces(span);
+
+	for(unsigned int i = 0; i < stripSpans[span].numFaces; ++i)
+	{
+		faces.push_back(strip[i]);
+		faceSpans[strip[i]] = DC_NO_FACE;
+	}
+
+	stripSpans[span].numFaces = 0;
+
+	DCIndexRange& range = stripSpans[span].range;
+	unsigned int hole = settings.output == DC_OUTPUT_RESTART ? DC_STRIP_CUT_32 : indices[range.start];
+
+	std::fill(indices.begin() + range.start, indices.begin() + range.start + range.count, hole);
+	patchedRanges.push_back(range);
+
+	holeSpans.push_back(span);
+}
+
+// Place strip - into the smallest hole of the strip's material that holds it with its
+// joins; the rest of the hole is padded so it draws nothing, and the strip takes over
+// the hole's range
+bool DCStripifier::placeStrip(const unsigned int* strip, unsigned int numFaces, const std::vector<unsigned int>& stripIndices)
+{
+	unsigned int material = model.getFace(strip[0])->getData().material;
+
+	unsigned int best = DC_NO_FACE; // Of the hole spans
+	unsigned int bestLead = 0;
+
+	for(unsigned int i = 0; i < holeSpans.size(); ++i)
+	{
+		const DCIndexRange& range = stripSpans[holeSpans[i]].range;
+		const DCSubmesh& submesh = submeshes[findSubmesh(range.start)];
+
+		if(submesh.material != material)
+			continue;
+
+		// Joins to the strips either side - a cut, or repeated indices
+		unsigned int lead = 0;
+		unsigned int trail = 0;
+
+		if(settings.output != DC_OUTPUT_SEPARATE && range.start > submesh.range.start)
+			lead = 1;
+
+		if(settings.output == DC_OUTPUT_STITCHED)
+		{
+			// Strips must start on an even index of the draw to keep their winding
+			if((range.start + lead - submesh.range.start) % 2)
+				lead += 1;
+
+			if(range.start + range.count < submesh.range.start + submesh.range.count)
+				trail = 1;
+		}
+
+		if(lead + stripIndices.size() + trail > range.count)
+			continue;
+
+		if(best == DC_NO_FACE || range.count < stripSpans[holeSpans[best]].range.count)
+		{
+			best = i;
+			bestLead = lead;
+		}
+	}
+
+	if(best == DC_NO_FACE)
+		return false;
+
+	unsigned int hole = holeSpans[best];
+
+	DCStripSpan span;
+	span.numFaces = numFaces;
+	span.range = stripSpans[hole].range;
+
+	// Restart joins and padding are cuts; the others repeat the strip's first and last index
+	unsigned int first = settings.output == DC_OUTPUT_RESTART ? DC_STRIP_CUT_32 : stripIndices.front();
+	unsigned int last = settings.output == DC_OUTPUT_RESTART ? DC_STRIP_CUT_32 : stripIndices.back();
+
+	std::vector<unsigned int>::iterator start = indices.begin() + span.range.start;
+
+	std::fill(start, start + bestLead, first);
+	std::copy(stripIndices.begin(), stripIndices.end(), start + bestLead);
+	std::fill(start + bestLead + stripIndices.size(), start + span.range.count, last);
+
+	joinIndices += span.range.count - stripIndices.size();
+	patchedRanges.push_back(span.range);
+
+	// The hole's range moves to the new strip
+	stripSpans[hole].range.count = 0;
+
+	holeSpans[best] = holeSpans.back();
+	holeSpans.pop_back();
+
+	if(tailSpan == hole)
+		tailSpan = stripSpans.size();
+
+	strips.addStrip(strip, numFaces);
+
+	for(unsigned int i = 0; i < numFaces; ++i)
+		faceSpans[strip[i]] = stripSpans.size();
+
+	stripSpans.push_back(span);
+
+	return true;
+}
+
+// Append strip - emitted after the last strip and joined to it as build joins strips,
+// if the last submesh has the strip's material; otherwise it starts a submesh
+void DCStripifier::appendStrip(const unsigned int* strip, unsigned int numFaces, const std::vector<unsigned int>& stripIndices)
+{
+	unsigned int material = model.getFace(strip[0])->getData().material;
+
+	bool join = !submeshes.empty() && submeshes.back().material == material;
+
+	if(!join)
+	{
+		beginSubmesh(material);
+
+		// Joined layouts draw each submesh at once
+		if(settings.output != DC_OUTPUT_SEPARATE)
+		{
+			drawCounts.push_back(0);
+			submeshes.back().numDraws = 1;
+		}
+	}
+
+	DCStripSpan span;
+	span.numFaces = numFaces;
+	span.range.start = indices.size();
+
+	unsigned int joinStart = indices.size();
+
+	if(settings.output == DC_OUTPUT_RESTART && join)
+		indices.push_back(DC_STRIP_CUT_32);
+	else if(settings.output == DC_OUTPUT_STITCHED && join)
+	{
+		// The repeated last index belongs to the last strip's range
+		indices.push_back(indices.back());
+		stripSpans[tailSpan].range.count += 1;
+		span.range.start = indices.size();
+
+		indices.push_back(stripIndices[0]);
+
+		// Strips must start on an even index of the draw to keep their winding
+		if((indices.size() - submeshes.back().range.start) % 2)
+			indices.push_back(stripIndices[0]);
+	}
+
+	joinIndices += indices.size() - joinStart;
+
+	indices.insert(indices.end(), stripIndices.begin(), stripIndices.end());
+	span.range.count = indices.size() - span.range.start;
+
+	submeshes.back().range.count = indices.size() - submeshes.back().range.start;
+
+	if(settings.output == DC_OUTPUT_SEPARATE)
+	{
+		drawCounts.push_back(stripIndices.size());
+		submeshes.back().numDraws += 1;
+	}
+	else
+		drawCounts.back() = submeshes.back().range.count;
+
+	strips.addStrip(strip, numFaces);
+
+	for(unsigned int i = 0; i < numFaces; ++i)
+		faceSpans[strip[i]] = stripSpans.size();
+
+	tailSpan = stripSpans.size();
+	stripSpans.push_back(span);
+}
+
+// Compact strips - every drawn strip emitted again in index order, grouped by material
+// as a build groups them, with no holes; the whole index array is patched
+void DCStripifier::compactStrips()
+{
+	std::vector<unsigned int> order;
+
+	for(unsigned int i = 0; i < stripSpans.size(); ++i)
+		if(stripSpans[i].numFaces)
+			order.push_back(i);
+
+	std::sort(order.begin(), order.end(), DCSpanOrder(stripSpans));
+
+	DCStripList drawn;
+	drawn.reserve(strips.getNumFaces());
+
+	for(unsigned int i = 0; i < order.size(); ++i)
+		drawn.addStrip(strips.getFaces(order[i]), stripSpans[order[i]].numFaces);
+
+	strips.swap(drawn);
+	groupStrips();
+
+	joinIndices = 0;
+	emitStrips();
+
+	if(settings.output == DC_OUTPUT_RESTART)
+		joinRestart();
+	else if(settings.output == DC_OUTPUT_STITCHED)
+		joinStitched();
+
+	DCIndexRange range;
+	range.start = 0;
+	range.count = indices.size();
+
+	patchedRanges.assign(1, range);
+}
+
+// Find submesh - submeshes are in index order
+unsigned int DCStripifier::findSubmesh(unsigned int index) const
+{
+	unsigned int low = 0;
+	unsigned int high = submeshes.size();
+
+	while(high - low > 1)
+	{
+		unsigned int middle = (low + high) / 2;
+
+		if(submeshes[middle].range.start <= index)
+			low = middle;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+// Restore output - built arrays taken as they are; strips and faces are not kept
+void DCStripifier::restoreOutput(std::vector<DCStripVertex>& vertices, std::vector<unsigned int>& indices, std::vector<unsigned int>& drawCounts,
+	std::vector<DCSubmesh>& submeshes, std::vector<DCStripSpan>& stripSpans, bool textured)
+{
+	strips.clear();
+	duplications.clear();
+	duplicationIds.clear();
+	vertexIds.clear();
+	adjacency.clear();
+	texCoords.clear();
+	model.clear();
+
+	faceRegions.clear();
+	faceSpans.clear();
+	holeSpans.clear();
+	patchedRanges.clear();
+
+	this->vertices.swap(vertices);
+	this->indices.swap(indices);
+	this->drawCounts.swap(drawCounts);
+	this->submeshes.swap(submeshes);
+	this->stripSpans.swap(stripSpans);
+	this->textured = textured;
+
+	joinIndices = 0;
+	swaps = 0;
+	untunnelledStrips = 0;
+	regionCuts = 0;
+	largestRegion = 0;
+
+	report = DCStripReport();
+	fillReport();
+}
+
+// Fill report - output counts and strip lengths, then the retained memory
+void DCStripifier::fillReport()
+{
+	report.faces = model.getNumFaces();
+	report.strips = 0;
+	report.indices = indices.size();
+	report.draws = drawCounts.size();
+	report.submeshes = submeshes.size();
+	report.swaps = swaps;
+	report.joinIndices = joinIndices;
+	report.duplications = duplications.size();
+	report.stripLengths.clear();
+
+	for(unsigned int i = 0; i < stripSpans.size(); ++i)
+	{
+		if(stripSpans[i].numFaces)
+		{
+			report.strips += 1;
+			report.addStripLength(stripSpans[i].numFaces);
+		}
+	}
+
+	sampleMemory();
+}
+
+// Sample memory - container capacities; hash map nodes are estimated
+void DCStripifier::sampleMemory()
+{
+	report.sampleMemory("dcelVertices", model.getVertices().capacity() * sizeof(DCMesh::Vertex));
+	report.sampleMemory("dcelHalfEdges", model.getHalfEdges().capacity() * sizeof(DCMesh::HalfEdge));
+	report.sampleMemory("dcelFaces", model.getFaces().capacity() * sizeof(DCMesh::Face));
+
+	report.sampleMemory("duplications", duplications.capacity() * sizeof(vDuplication) + duplicationIds.bucket_count() * sizeof(void*) +
+		duplicationIds.size() * (sizeof(std::pair<unsigned long long, unsigned int>) + 2 * sizeof(void*)));
+
+	report.sampleMemory("strips", strips.getBytes() + editBuild.strips.getBytes());
+
+	report.sampleMemory("faceTables", (vertexIds.capacity() + vertexFaceStart.capacity() + vertexFaces.capacity() + faceRegions.capacity() + faceSpans.capacity()) * sizeof(unsigned int) +
+		stripSpans.capacity() * sizeof(DCStripSpan));
+
+	report.sampleMemory("adjacency", adjacency.capacity() * sizeof(DCFaceAdjacency));
+
+	report.sampleMemory("tunnelling", (tunnelLinks.capacity() + tunnelNeighbours.capacity() + tunnelStamps.capacity() + tunnelParents.capacity()) * sizeof(unsigned int));
+
+	report.sampleMemory("faceQueues", editBuild.freeFaces.getBytes() + editBuild.faces.capacity() * sizeof(DCFaceState));
+
+	report.sampleMemory("vertices", vertices.capacity() * sizeof(DCStripVertex) + texCoords.capacity() * sizeof(float));
+	report.sampleMemory("indices", (indices.capacity() + drawCounts.capacity()) * sizeof(unsigned int));
+}
+
+// Grow strips - copy the face states, queue the build's free faces by degree and strip them all
+void DCStripifier::growStrips(DCStripBuild& build)
+{
+	int maxDegree = 0;
+
+	build.faces.resize(model.getNumFaces());
+
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	{
+		build.faces[i].free = model.getFace(i)->getData().free;
+		build.faces[i].degree = model.getFace(i)->getData().degree;
+
+		if(isInRegion(build, i) && build.faces[i].degree > maxDegree)
+			maxDegree = build.faces[i].degree;
+	}
+
+	build.freeFaces.setup(model.getNumFaces(), maxDegree);
+
+	if(!build.seedOrder.empty())
+		build.freeFaces.setOrder(build.seedOrder);
+
+	unsigned int numQueued = 0;
+
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+	{
+		if(isInRegion(build, i) && build.faces[i].free)
+		{
+			build.freeFaces.push(i, build.faces[i].degree);
+			numQueued += 1;
+		}
+	}
+
+	// Strips of the queued faces - reserved once
+	build.strips.clear();
+	build.strips.reserve(numQueued);
+
+	stripFreeFaces(build);
+}
+
+// Strip free faces - strips from the queued faces until none are left, grown by
+// the strategy's builder; the policies are resolved here, once per build
+void DCStripifier::stripFreeFaces(DCStripBuild& build)
+{
+	DCStripContext context;
+	context.model = &model;
+	context.settings = &settings;
+	context.adjacency = &adjacency;
+	context.faceRegions = &faceRegions;
+	context.vertexFaceStart = &vertexFaceStart;
+	context.vertexFaces = &vertexFaces;
+
+	if(stripGrowth)
+		stripGrowth(context, build);
+	else if(settings.strategy == DC_STRATEGY_CACHE)
+		DCStripBuilder<DCCachedSeed, DCCachedNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces(context, build);
+	else if(settings.strategy == DC_STRATEGY_LOOKAHEAD)
+		DCStripBuilder<DCLowestDegreeSeed, DCLookAheadNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces(context, build);
+	else if(settings.strategy == DC_STRATEGY_TREE)
+		DCStripTree<DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces(context, build);
+	else
+		DCStripBuilder<DCLowestDegreeSeed, DCDegreeNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces(context, build);
+}
+
+// Is in region - a build only touches visible faces of its own region
+bool DCStripifier::isInRegion(const DCStripBuild& build, unsigned int face) const
+{
+	if(model.getFace(face)->getData().hidden)
+		return false;
+
+	return build.region == DC_NO_REGION || faceRegions[face] == build.region;
+}
+
+// Partition faces - each region grows breadth first from its own boundary:
+// seam-free neighbours first, then neighbours across a seam, which strips
+// never cross anyway. A full region hands its frontier to the next region.
+// A region with no unassigned face left next to it moves on to the piece of
+// unassigned faces at the lowest id. A piece of another mesh component is
+// added to the region. A small pocket enclosed by other regions joins the
+// region it shares most edges with. Any other piece starts the next region;
+// a region too small to keep is first given to its neighbours the same way.
+// The regions are then balanced
+void DCStripifier::partitionFaces(unsigned int numRegions)
+{
+	unsigned int numFaces = model.getNumFaces();
+
+	// Pockets and stub regions up to a quarter of a region's share are merged
+	unsigned int smallPiece = numFaces / numRegions / 4;
+
+	faceRegions.assign(numFaces, DC_NO_REGION);
+
+	std::deque<unsigned int> frontier;
+	std::deque<unsigned int> seamFrontier; // Across a seam - taken once the frontier is empty
+	std::vector<unsigned int> members; // Faces of the region
+	std::vector<unsigned int> piece;
+	std::vector<unsigned int> contacts(numRegions);
+
+	unsigned int region = 0;
+	unsigned int assigned = 0;
+	unsigned int target = (numFaces + numRegions - 1) / numRegions;
+	unsigned int seed = 0;
+
+	while(assigned < numFaces)
+	{
+		// Region full - the next region starts from the first unassigned frontier face
+		if(members.size() >= target && region + 1 < numRegions)
+		{
+			unsigned int next = DC_NO_FACE;
+
+			while(next == DC_NO_FACE && !frontier.empty())
+			{
+				if(faceRegions[frontier.front()] == DC_NO_REGION)
+					next = frontier.front();
+
+				frontier.pop_front();
+			}
+
+			while(next == DC_NO_FACE && !seamFrontier.empty())
+			{
+				if(faceRegions[seamFrontier.front()] == DC_NO_REGION)
+					next = seamFrontier.front();
+
+				seamFrontier.pop_front();
+			}
+
+			++region;
+			members.clear();
+			target = (numFaces - assigned + numRegions - region - 1) / (numRegions - region);
+
+			frontier.clear();
+			seamFrontier.clear();
+
+			if(next != DC_NO_FACE)
+				frontier.push_back(next);
+		}
+
+		// Seam-free neighbours exhausted - cross a seam of the region
+		if(frontier.empty())
+		{
+			while(!seamFrontier.empty() && faceRegions[seamFrontier.front()] != DC_NO_REGION)
+				seamFrontier.pop_front();
+
+			if(!seamFrontier.empty())
+			{
+				frontier.push_back(seamFrontier.front());
+				seamFrontier.pop_front();
+			}
+		}
+
+		// Nothing unassigned next to the region - the piece at the lowest unassigned face
+		if(frontier.empty())
+		{
+			while(faceRegions[seed] != DC_NO_REGION)
+				++seed;
+
+			// Faces reached over any edge - marked numRegions while collected
+			piece.assign(1, seed);
+			faceRegions[seed] = numRegions;
+
+			for(unsigned int i = 0; i < piece.size(); ++i)
+			{
+				for(unsigned int j = 0; j < 3; ++j)
+				{
+					unsigned int neighbour = adjacency[piece[i]].neighbours[j];
+
+					if(neighbour != DC_NO_FACE && faceRegions[neighbour] == DC_NO_REGION)
+					{
+						faceRegions[neighbour] = numRegions;
+						piece.push_back(neighbour);
+					}
+				}
+			}
+
+			unsigned int pieceRegion = findContactRegion(piece, numRegions, contacts);
+
+			// Pocket - joins its neighbour
+			if(pieceRegion != DC_NO_REGION && piece.size() <= smallPiece)
+			{
+				for(unsigned int i = 0; i < piece.size(); ++i)
+					faceRegions[piece[i]] = pieceRegion;
+
+				assigned += piece.size();
+				continue;
+			}
+
+			for(unsigned int i = 0; i < piece.size(); ++i)
+				faceRegions[piece[i]] = DC_NO_REGION;
+
+			// Enclosed by other regions - the region ends here
+			if(pieceRegion != DC_NO_REGION && !members.empty())
+			{
+				unsigned int stubRegion = findContactRegion(members, region, contacts);
+
+				// Stub - given to its neighbour, and the region starts again on the piece
+				if(stubRegion != DC_NO_REGION && members.size() <= smallPiece)
+				{
+					for(unsigned int i = 0; i < members.size(); ++i)
+						faceRegions[members[i]] = stubRegion;
+
+					members.clear();
+				}
+				else if(region + 1 < numRegions)
+				{
+					++region;
+					members.clear();
+					target = (numFaces - assigned + numRegions - region - 1) / (numRegions - region);
+				}
+			}
+
+			frontier.push_back(seed);
+		}
+
+		unsigned int faceId = frontier.front();
+		frontier.pop_front();
+
+		if(faceRegions[faceId] != DC_NO_REGION)
+			continue;
+
+		faceRegions[faceId] = region;
+		members.push_back(faceId);
+		++assigned;
+
+		const DCFaceAdjacency& adjacent = adjacency[faceId];
+
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			unsigned int neighbour = adjacent.neighbours[i];
+
+			if(neighbour == DC_NO_FACE || faceRegions[neighbour] != DC_NO_REGION)
+				continue;
+
+			if(adjacent.seams & (1 << i))
+				seamFrontier.push_back(neighbour);
+			else
+				frontier.push_back(neighbour);
+		}
+	}
+
+	// Regions grown in turn leave the last ones with what is left over
+	balanceRegions(numRegions);
+
+	// Count seam-free edges between regions - strips cannot cross them
+	for(unsigned int i = 0; i < numFaces; ++i)
+	{
+		const DCFaceAdjacency& adjacent = adjacency[i];
+
+		for(unsigned int j = 0; j < 3; ++j)
+		{
+			unsigned int neighbour = adjacent.neighbours[j];
+
+			if(neighbour != DC_NO_FACE && neighbour > i && !(adjacent.seams & (1 << j)) && faceRegions[neighbour] != faceRegions[i])
+				++regionCuts;
+		}
+	}
+}
+
+// Balance regions - a region over its share of the faces gives boundary faces to
+// a neighbouring region at least two faces smaller, until no face can move. Faces
+// whose move does not lengthen the seam-free cut go first, which keeps the boundary
+// smooth and on seams where it can; the others only move while the region is over
+// its share by an eighth, as every cut edge can cost a strip. A face whose removal
+// may split its region stays. Every move shrinks the sum of squared region sizes,
+// so the passes end
+void DCStripifier::balanceRegions(unsigned int numRegions)
+{
+	unsigned int numFaces = model.getNumFaces();
+	unsigned int share = (numFaces + numRegions - 1) / numRegions;
+
+	std::vector<unsigned int> sizes(numRegions, 0);
+
+	for(unsigned int i = 0; i < numFaces; ++i)
+		sizes[faceRegions[i]] += 1;
+
+	std::deque<unsigned int> corners; // Faces whose move may not lengthen the cut
+	std::deque<unsigned int> boundary;
+	bool moved = true;
+
+	while(moved)
+	{
+		moved = false;
+
+		for(unsigned int i = 0; i < numFaces; ++i)
+		{
+			if(sizes[faceRegions[i]] > share)
+				boundary.push_back(i);
+		}
+
+		while(!corners.empty() || !boundary.empty())
+		{
+			bool corner = !corners.empty();
+			std::deque<unsigned int>& queue = corner ? corners : boundary;
+
+			unsigned int faceId = queue.front();
+			queue.pop_front();
+
+			unsigned int region = faceRegions[faceId];
+
+			if(sizes[region] <= share)
+				continue;
+
+			// Smallest neighbouring region that stays smaller after the move
+			unsigned int target = DC_NO_REGION;
+
+			for(unsigned int i = 0; i < 3; ++i)
+			{
+				unsigned int neighbour = adjacency[faceId].neighbours[i];
+
+				if(neighbour == DC_NO_FACE)
+					continue;
+
+				unsigned int other = faceRegions[neighbour];
+
+				if(other != region && sizes[other] + 1 < sizes[region] && (target == DC_NO_REGION || sizes[other] < sizes[target]))
+					target = other;
+			}
+
+			if(target == DC_NO_REGION)
+				continue;
+
+			// Seam-free edges cut after the move less those cut before
+			int cutChange = 0;
+
+			for(unsigned int i = 0; i < 3; ++i)
+			{
+				unsigned int neighbour = adjacency[faceId].neighbours[i];
+
+				if(neighbour == DC_NO_FACE || (adjacency[faceId].seams & (1 << i)))
+					continue;
+
+				cutChange += (faceRegions[neighbour] != target) - (faceRegions[neighbour] != region);
+			}
+
+			// Lengthens the cut - waits until no corner can move
+			if(cutChange > 0 && corner)
+			{
+				boundary.push_back(faceId);
+				continue;
+			}
+
+			if(cutChange > 0 && sizes[region] <= share + share / 8)
+				continue;
+
+			if(cutChange > 0 && !corners.empty())
+			{
+				boundary.push_front(faceId);
+				continue;
+			}
+
+			if(isRegionBridge(faceId))
+				continue;
+
+			faceRegions[faceId] = target;
+			sizes[region] -= 1;
+			sizes[target] += 1;
+			moved = true;
+
+			// Neighbours left in the region may now be corners
+			for(unsigned int i = 0; i < 3; ++i)
+			{
+				unsigned int neighbour = adjacency[faceId].neighbours[i];
+
+				if(neighbour != DC_NO_FACE && faceRegions[neighbour] == region)
+					corners.push_back(neighbour);
+			}
+		}
+	}
+
+	largestRegion = *std::max_element(sizes.begin(), sizes.end());
+}
+
+// Is region bridge - true unless the face's neighbours in its region reach each
+// other within a few faces of the region without it. Local, so a face joining
+// them only around a larger loop counts as a bridge and stays
+bool DCStripifier::isRegionBridge(unsigned int face) const
+{
+	// Faces searched before giving up - a vertex fan is rarely larger
+	static const unsigned int maxSearch = 32;
+
+	unsigned int region = faceRegions[face];
+	unsigned int ends[3];
+	unsigned int numEnds = 0;
+
+	for(unsigned int i = 0; i < 3; ++i)
+	{
+		unsigned int neighbour = adjacency[face].neighbours[i];
+
+		if(neighbour != DC_NO_FACE && faceRegions[neighbour] == region)
+			ends[numEnds++] = neighbour;
+	}
+
+	if(numEnds < 2)
+		return false;
+
+	// Breadth first from the first neighbour, around the face
+	unsigned int searched[maxSearch];
+	unsigned int numSearched = 1;
+	unsigned int found = 1;
+
+	searched[0] = ends[0];
+
+	for(unsigned int i = 0; i < numSearched && found < numEnds; ++i)
+	{
+		for(unsigned int j = 0; j < 3; ++j)
+		{
+			unsigned int neighbour = adjacency[searched[i]].neighbours[j];
+
+			if(neighbour == DC_NO_FACE || neighbour == face || faceRegions[neighbour] != region ||
+				std::find(searched, searched + numSearched, neighbour) != searched + numSearched)
+				continue;
+
+			if(numSearched == maxSearch)
+				return true;
+
+			searched[numSearched++] = neighbour;
+
+			if(std::find(ends + 1, ends + numEnds, neighbour) != ends + numEnds)
+				++found;
+		}
+	}
+
+	return found < numEnds;
+}
+
+// Find contact region - the region sharing most edges with the faces, lowest first on a
+// tie; faces of the excluded region and unassigned faces do not count
+unsigned int DCStripifier::findContactRegion(const std::vector<unsigned int>& faces, unsigned int exclude, std::vector<unsigned int>& contacts) const
+{
+	unsigned int best = DC_NO_REGION;
+
+	std::fill(contacts.begin(), contacts.end(), 0);
+
+	for(unsigned int i = 0; i < faces.size(); ++i)
+	{
+		for(unsigned int j = 0; j < 3; ++j)
+		{
+			unsigned int neighbour = adjacency[faces[i]].neighbours[j];
+
+			if(neighbour == DC_NO_FACE || faceRegions[neighbour] >= contacts.size() || faceRegions[neighbour] == exclude)
+				continue;
+
+			unsigned int other = faceRegions[neighbour];
+			contacts[other] += 1;
+
+			if(best == DC_NO_REGION || contacts[other] > contacts[best] || (contacts[other] == contacts[best] && other < best))
+				best = other;
+		}
+	}
+
+	return best;
+}
+
+// Grow seed runs - each run strips every face from its own copy of the face states;
+// run 0 seeds in face id order, so the kept run is never worse than a single build
+void DCStripifier::growSeedRuns(DCStripBuild& build)
+{
+	unsigned int numRuns = settings.seedRuns;
+
+	std::vector<DCStripBuild> runs(numRuns);
+	std::vector<double> scores(numRuns, 0);
+
+	unsigned int numThreads = std::thread::hardware_concurrency();
+
+	if(numThreads < 1)
+		numThreads = 1;
+
+	if(numThreads > numRuns)
+		numThreads = numRuns;
+
+	// Run i grows on thread i % numThreads
+	std::vector<std::thread> workers;
+
+	for(unsigned int i = 1; i < numThreads; ++i)
+		workers.push_back(std::thread(&DCStripifier::runSeeds, this, &runs, &scores, i, numThreads));
+
+	runSeeds(&runs, &scores, 0, numThreads);
+
+	for(unsigned int i = 0; i < workers.size(); ++i)
+		workers[i].join();
+
+	// Lowest score - the earliest run on ties
+	unsigned int best = 0;
+	unsigned long long runBytes = 0;
+
+	for(unsigned int i = 0; i < numRuns; ++i)
+	{
+		if(scores[i] < scores[best])
+			best = i;
+
+		runBytes += runs[i].freeFaces.getBytes() + runs[i].faces.capacity() * sizeof(DCFaceState) + runs[i].seedOrder.capacity() * sizeof(unsigned int);
+	}
+
+	report.sampleMemory("faceQueues", runBytes);
+
+	build.strips.swap(runs[best].strips);
+
+	cerr << numRuns << " seed runs on " << numThreads << " threads, run " << best << " kept (score " << scores[best] << ", first run " << scores[0] << ")." << endl;
+}
+
+// Run seeds - every step-th run from first; runs after the first seed in a shuffled order
+void DCStripifier::runSeeds(std::vector<DCStripBuild>* runs, std::vector<double>* scores, unsigned int first, unsigned int step)
+{
+	for(unsigned int i = first; i < runs->size(); i += step)
+	{
+		DCStripBuild& run = (*runs)[i];
+
+		if(i > 0)
+		{
+			run.seedOrder.resize(model.getNumFaces());
+
+			for(unsigned int j = 0; j < run.seedOrder.size(); ++j)
+				run.seedOrder[j] = j;
+
+			std::mt19937 random(i);
+			std::shuffle(run.seedOrder.begin(), run.seedOrder.end(), random);
+		}
+
+		growStrips(run);
+		(*scores)[i] = scoreStrips(run.strips);
+	}
+}
+
+// Score strips - by the settings' seed score, the strips emitted as separate draws
+double DCStripifier::scoreStrips(const DCStripList& strips)
+{
+	if(settings.seedScore == DC_SEED_SCORE_STRIPS)
+		return strips.size();
+
+	std::vector<unsigned int> indexVec;
+	std::vector<unsigned int> counts;
+
+	for(unsigned int i = 0; i < strips.size(); ++i)
+	{
+		unsigned int start = indexVec.size();
+
+		emitStrip(strips.getFaces(i), strips.getNumFaces(i), indexVec);
+		counts.push_back(indexVec.size() - start);
+	}
+
+	if(settings.seedScore == DC_SEED_SCORE_INDICES)
+		return indexVec.size();
+
+	return DCCacheMetrics::measure(indexVec, counts, true, settings.cacheType, settings.cacheSize).acmr;
+}
+
+// Setup vertex faces - faces around each output vertex, as offsets into one array
+void DCStripifier::setupVertexFaces()
+{
+	unsigned int numVertices = model.getNumVertices() + duplications.size();
+
+	vertexFaceStart.assign(numVertices + 1, 0);
+	vertexFaces.resize(model.getNumFaces() * 3);
+
+	// Count faces per vertex
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+		for(int j = 0; j < 3; ++j)
+			vertexFaceStart[model.getFace(i)->getData().v[j] + 1] += 1;
+
+	for(unsigned int i = 0; i < numVertices; ++i)
+		vertexFaceStart[i + 1] += vertexFaceStart[i];
+
+	// Fill - faces stay in id order per vertex
+	std::vector<unsigned int> fill(vertexFaceStart.begin(), vertexFaceStart.end() - 1);
+
+	for(unsigned int i = 0; i < model.getNumFaces(); ++i)
+		for(int j = 0; j < 3; ++j)
+			vertexFaces[fill[model.getFace(i)->getData().v[j]]++] = i;
+}
+
+// Cluster of consecutive strips - sorted by how far it faces out from the mesh centre
+struct DCStripCluster
+{
+	unsigned int first; // First strip
+	unsigned int count;
+	float key;
+};
+
+static bool compareClusters(const DCStripCluster& a, const DCStripCluster& b)
+{
+	return a.key > b.key;
+}
+
+// List triangles - faces of the strips in the order given; faces keep their winding in strips
+static void listTriangles(const DCMesh& model, const DCStripList& strips, const std::vector<unsigned int>& order, std::vector<unsigned int>& triangles)
+{
+	triangles.clear();
+	triangles.reserve(strips.getNumFaces() * 3);
+
+	for(unsigned int i = 0; i < order.size(); ++i)
+		for(unsigned int j = 0; j < strips.getNumFaces(order[i]); ++j)
+			for(int k = 0; k < 3; ++k)
+				triangles.push_back(model.getFace(strips.getFaces(order[i])[j])->getData().v[k]);
+}
+
+// Fetch strip - a strip's emitted indices through the simulated cache, after
+// the join to the strip emitted before it in a stitched draw
+static void fetchStrip(DCVertexCache& cache, const std::vector<unsigned int>& stream, unsigned int start, unsigned int end, bool stitched)
+{
+	// The repeated last index and the first index - the parity repeat always hits
+	if(stitched)
+	{
+		cache.access(stream[start - 1]);
+		cache.access(stream[start]);
+	}
+
+	for(unsigned int i = start; i < end; ++i)
+		cache.access(stream[i]);
+}
+
+// Order strips - the strip order is cut into clusters that each restart the
+// simulated cache within overdrawThreshold of the whole order's ACMR, both
+// over the indices as emitted, then clusters facing out from the mesh centre
+// are drawn first. The order is kept only if it lowers the overdraw estimate
+void DCStripifier::orderStrips()
+{
+	unsigned int numStrips = strips.size();
+
+	if(numStrips < 2)
+		return;
+
+	// Emitted indices of each strip - strip cuts are never transformed
+	std::vector<unsigned int> stream;
+	std::vector<unsigned int> streamStarts(numStrips + 1);
+
+	stream.reserve(strips.getNumFaces() * 2 + numStrips);
+
+	for(unsigned int i = 0; i < numStrips; ++i)
+	{
+		streamStarts[i] = stream.size();
+		emitStrip(strips.getFaces(i), strips.getNumFaces(i), stream);
+	}
+
+	streamStarts[numStrips] = stream.size();
+
+	bool stitched = settings.output == DC_OUTPUT_STITCHED;
+
+	// ACMR of the strip order
+	DCVertexCache cache(settings.cacheType, settings.cacheSize);
+
+	for(unsigned int i = 0; i < numStrips; ++i)
+		fetchStrip(cache, stream, streamStarts[i], streamStarts[i + 1], stitched && i > 0);
+
+	float target = (float)cache.getMisses() / strips.getNumFaces() * settings.overdrawThreshold;
+
+	// Split into clusters - a cluster closes once its cold-cache ACMR is within the target
+	std::vector<DCStripCluster> clusters;
+	DCStripCluster cluster;
+	cluster.first = 0;
+	cluster.count = 0;
+	cluster.key = 0;
+
+	cache.clear();
+	unsigned int clusterTriangles = 0;
+
+	for(unsigned int i = 0; i < numStrips; ++i)
+	{
+		fetchStrip(cache, stream, streamStarts[i], streamStarts[i + 1], stitched && cluster.count > 0);
+
+		clusterTriangles += strips.getNumFaces(i);
+		cluster.count += 1;
+
+		if((float)cache.getMisses() / clusterTriangles <= target || i + 1 == numStrips)
+		{
+			clusters.push_back(cluster);
+
+			cluster.first = i + 1;
+			cluster.count = 0;
+			cache.clear();
+			clusterTriangles = 0;
+		}
+	}
+
+	// Mesh centre - area weighted face centres
+	std::vector<float> centres(clusters.size() * 3, 0);
+	std::vector<float> normals(clusters.size() * 3, 0);
+	std::vector<float> areas(clusters.size(), 0);
+	float meshCentre[3] = {0, 0, 0};
+	float meshArea = 0;
+
+	for(unsigned int c = 0; c < clusters.size(); ++c)
+	{
+		float area = 0;
+
+		for(unsigned int i = clusters[c].first; i < clusters[c].first + clusters[c].count; ++i)
+		{
+			for(unsigned int j = 0; j < strips.getNumFaces(i); ++j)
+			{
+				const FaceData& data = model.getFace(strips.getFaces(i)[j])->getData();
+				const float* p0 = vertices[data.v[0]].pos;
+				const float* p1 = vertices[data.v[1]].pos;
+				const float* p2 = vertices[data.v[2]].pos;
+
+				// Normal length is twice the face area
+				float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+				float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+				float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+				float faceArea = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) / 2;
+
+				for(int k = 0; k < 3; ++k)
+				{
+					centres[c * 3 + k] += (p0[k] + p1[k] + p2[k]) / 3 * faceArea;
+					normals[c * 3 + k] += n[k];
+				}
+
+				area += faceArea;
+			}
+		}
+
+		for(int k = 0; k < 3; ++k)
+			meshCentre[k] += centres[c * 3 + k];
+
+		meshArea += area;
+		areas[c] = area;
+
+		if(area > 0)
+			for(int k = 0; k < 3; ++k)
+				centres[c * 3 + k] /= area;
+	}
+
+	if(meshArea > 0)
+		for(int k = 0; k < 3; ++k)
+			meshCentre[k] /= meshArea;
+
+	// Key - distance from the mesh centre along the area weighted mean unit normal,
+	// so clusters with scattered normals sort towards the middle
+	for(unsigned int c = 0; c < clusters.size(); ++c)
+	{
+		clusters[c].key = 0;
+
+		if(areas[c] > 0)
+			for(int k = 0; k < 3; ++k)
+				clusters[c].key += (centres[c * 3 + k] - meshCentre[k]) * normals[c * 3 + k] / (areas[c] * 2);
+	}
+
+	std::stable_sort(clusters.begin(), clusters.end(), compareClusters);
+
+	// Rebuild the strip list in cluster order
+	std::vector<unsigned int> order;
+	order.reserve(numStrips);
+
+	for(unsigned int c = 0; c < clusters.size(); ++c)
+		for(unsigned int i = clusters[c].first; i < clusters[c].first + clusters[c].count; ++i)
+			order.push_back(i);
+
+	// Overdraw estimate of both orders as drawn - grouped by material after this pass
+	std::vector<unsigned int> stripOrder;
+	sortByMaterial(model, strips, stripOrder);
+
+	std::vector<unsigned int> clusterOrder(order);
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), DCStripMaterialOrder(model, strips));
+
+	std::vector<unsigned int> triangles;
+
+	listTriangles(model, strips, stripOrder, triangles);
+	float stripOverdraw = DCOverdraw::measure(vertices, triangles).overdraw;
+
+	listTriangles(model, strips, clusterOrder, triangles);
+	float clusterOverdraw = DCOverdraw::measure(vertices, triangles).overdraw;
+
+	if(clusterOverdraw >= stripOverdraw)
+	{
+		cerr << clusters.size() << " strip clusters kept in strip order - overdraw " << clusterOverdraw << " against " << stripOverdraw << "." << endl;
+		return;
+	}
+
+	strips.reorder(order);
+
+	cerr << clusters.size() << " strip clusters ordered for overdraw." << endl;
+}
+
+// Tunnel strips - a tunnel is an alternating path through the dual graph
+// between two strip ends; it starts and ends on non-strip edges, so
+// swapping which of its edges are in strips joins two strips into one
+void DCStripifier::tunnelStrips()
+{
+	unsigned int numFaces = model.getNumFaces();
+
+	tunnelLinks.assign(numFaces * 2, DC_NO_FACE);
+	tunnelNeighbours.assign(numFaces * 3, DC_NO_FACE);
+	tunnelStamps.assign(numFaces, 0);
+	tunnelParents.assign(numFaces, DC_NO_FACE);
+	tunnelSearch = 0;
+
+	// Neighbours a strip may continue into
+	for(unsigned int i = 0; i < numFaces; ++i)
+	{
+		if(model.getFace(i)->getData().hidden)
+			continue;
+
+		for(unsigned int j = 0; j < 3; ++j)
+		{
+			unsigned int neighbour = adjacency[i].neighbours[j];
+
+			if(neighbour != DC_NO_FACE && !model.getFace(neighbour)->getData().hidden && !(adjacency[i].seams & (1 << j)))
+				tunnelNeighbours[i * 3 + j] = neighbour;
+		}
+	}
+
+	// Link consecutive strip faces
+	for(unsigned int s = 0; s < strips.size(); ++s)
+		for(unsigned int i = 1; i < strips.getNumFaces(s); ++i)
+			addLink(strips.getFaces(s)[i - 1], strips.getFaces(s)[i]);
+
+	// Search from each strip end until the budget is spent or a pass finds nothing
+	unsigned int iterations = 0;
+	bool merged = true;
+
+	while(merged && iterations < settings.tunnelIterations)
+	{
+		merged = false;
+
+		for(unsigned int i = 0; i < numFaces && iterations < settings.tunnelIterations; ++i)
+		{
+			// Only strip ends - fewer than two links
+			if(tunnelLinks[i * 2 + 1] != DC_NO_FACE || model.getFace(i)->getData().hidden)
+				continue;
+
+			if(findTunnel(i))
+				merged = true;
+
+			++iterations;
+		}
+	}
+
+	rebuildStrips();
+}
+
+// Find tunnel - breadth first over alternating paths from a strip end
+bool DCStripifier::findTunnel(unsigned int face)
+{
+	++tunnelSearch;
+
+	tunnelStamps[face] = tunnelSearch;
+	tunnelParents[face] = DC_NO_FACE;
+
+	// Faces reached along a strip edge - the next step leaves on a non-strip edge
+	std::vector<unsigned int> level(1, face);
+	std::vector<unsigned int> nextLevel;
+	std::vector<unsigned int> path;
+
+	for(unsigned int depth = 0; depth < settings.tunnelDepth && !level.empty(); ++depth)
+	{
+		nextLevel.clear();
+
+		for(unsigned int i = 0; i < level.size(); ++i)
+		{
+			unsigned int current = level[i];
+
+			for(unsigned int j = 0; j < 3; ++j)
+			{
+				unsigned int neighbour = tunnelNeighbours[current * 3 + j];
+
+				if(neighbour == DC_NO_FACE || tunnelStamps[neighbour] == tunnelSearch || isLinked(current, neighbour))
+					continue;
+
+				tunnelStamps[neighbour] = tunnelSearch;
+				tunnelParents[neighbour] = current;
+
+				// Another strip end closes the tunnel
+				if(tunnelLinks[neighbour * 2 + 1] == DC_NO_FACE)
+				{
+					path.clear();
+
+					for(unsigned int k = neighbour; k != DC_NO_FACE; k = tunnelParents[k])
+						path.push_back(k);
+
+					if(applyTunnel(path))
+						return true;
+				}
+
+				// Continue along the neighbour's strip edges
+				for(unsigned int k = 0; k < 2; ++k)
+				{
+					unsigned int next = tunnelLinks[neighbour * 2 + k];
+
+					if(next == DC_NO_FACE || tunnelStamps[next] == tunnelSearch)
+						continue;
+
+					tunnelStamps[next] = tunnelSearch;
+					tunnelParents[next] = neighbour;
+					nextLevel.push_back(next);
+				}
+			}
+		}
+
+		level.swap(nextLevel);
+	}
+
+	return false;
+}
+
+// Apply tunnel - keeps the flip only if every strip it touches stays an open path within maxLength
+bool DCStripifier::applyTunnel(const std::vector<unsigned int>& path)
+{
+	flipTunnel(path, true);
+
+	for(unsigned int i = 0; i < path.size(); ++i)
+	{
+		unsigned int length = stripLength(path[i]);
+
+		if(length == 0 || length > settings.maxLength)
+		{
+			flipTunnel(path, false);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Flip tunnel - even edges join strips, odd edges leave them; reversed when not applying
+void DCStripifier::flipTunnel(const std::vector<unsigned int>& path, bool apply)
+{
+	// Remove before adding so no face holds more than two links
+	for(unsigned int i = 0; i + 1 < path.size(); ++i)
+	{
+		if((i % 2 == 1) == apply)
+			removeLink(path[i], path[i + 1]);
+	}
+
+	for(unsigned int i = 0; i + 1 < path.size(); ++i)
+	{
+		if((i % 2 == 0) == apply)
+			addLink(path[i], path[i + 1]);
+	}
+}
+
+// Add link - first free slot of each face
+void DCStripifier::addLink(unsigned int face1, unsigned int face2)
+{
+	tunnelLinks[face1 * 2 + (tunnelLinks[face1 * 2] == DC_NO_FACE ? 0 : 1)] = face2;
+	tunnelLinks[face2 * 2 + (tunnelLinks[face2 * 2] == DC_NO_FACE ? 0 : 1)] = face1;
+}
+
+// Remove link - keeps the remaining link in the first slot
+void DCStripifier::removeLink(unsigned int face1, unsigned int face2)
+{
+	unsigned int faces[2] = {face1, face2};
+	unsigned int others[2] = {face2, face1};
+
+	for(unsigned int i = 0; i < 2; ++i)
+	{
+		unsigned int* links = &tunnelLinks[faces[i] * 2];
+
+		if(links[0] == others[i])
+			links[0] = links[1];
+
+		links[1] = DC_NO_FACE;
+	}
+}
+
+bool DCStripifier::isLinked(unsigned int face1, unsigned int face2) const
+{
+	return tunnelLinks[face1 * 2] == face2 || tunnelLinks[face1 * 2 + 1] == face2;
+}
+
+// Next link - the link of face that is not prev
+unsigned int DCStripifier::nextLink(unsigned int face, unsigned int prev) const
+{
+	if(tunnelLinks[face * 2] != DC_NO_FACE && tunnelLinks[face * 2] != prev)
+		return tunnelLinks[face * 2];
+
+	if(tunnelLinks[face * 2 + 1] != prev)
+		return tunnelLinks[face * 2 + 1];
+
+	return DC_NO_FACE;
+}
+
+// Strip length - faces in the strip holding face
+unsigned int DCStripifier::stripLength(unsigned int face) const
+{
+	// Walk to one end
+	unsigned int prev = DC_NO_FACE;
+	unsigned int current = face;
+
+	for(unsigned int next = nextLink(current, prev); next != DC_NO_FACE; next = nextLink(current, prev))
+	{
+		prev = current;
+		current = next;
+
+		if(current == face)
+			return 0;
+	}
+
+	// Count to the other end
+	unsigned int length = 1;
+	prev = DC_NO_FACE;
+
+	for(unsigned int next = nextLink(current, prev); next != DC_NO_FACE; next = nextLink(current, prev))
+	{
+		prev = current;
+		current = next;
+		++length;
+	}
+
+	return length;
+}
+
+// Rebuild strips from the links - strips keep the order of the strips they grew from
+void DCStripifier::rebuildStrips()
+{
+	DCStripList linked;
+	std::vector<bool> visited(model.getNumFaces(), false);
+
+	linked.reserve(strips.getNumFaces());
+
+	for(unsigned int s = 0; s < strips.size(); ++s)
+	{
+		for(unsigned int i = 0; i < strips.getNumFaces(s); ++i)
+		{
+			unsigned int face = strips.getFaces(s)[i];
+
+			if(visited[face])
+				continue;
+
+			// Walk to one end
+			unsigned int prev = DC_NO_FACE;
+
+			for(unsigned int next = nextLink(face, prev); next != DC_NO_FACE; next = nextLink(face, prev))
+			{
+				prev = face;
+				face = next;
+			}
+
+			// Collect to the other end
+			prev = DC_NO_FACE;
+
+			while(face != DC_NO_FACE)
+			{
+				linked.addFace(face);
+				visited[face] = true;
+
+				unsigned int next = nextLink(face, prev);
+				prev = face;
+				face = next;
+			}
+
+			linked.endStrip();
+		}
+	}
+
+	strips.swap(linked);
+}
+
+// Check texture seam
+bool DCStripifier::isTextureSeam(DCMesh::Face* face1, DCMesh::Face* face2)
+{
+	if(textured)
+	{
+		// A count for the number of different indices
+		int difference = 0;
+
+		// If the index is found
+		bool found = false;
+
+		// If there is more than a single different index - there is a texture seam
+		for(int i = 0; i < 3; ++i)
+		{
+			for(int j = 0; j < 3; ++j)
+				if(face1->getData().v[i] == face2->getData().v[j])
+					found = true;
+
+			if(!found)
+				difference += 1;
+
+			// Reset found
+			found = false;
+		}
+
+		// Returns 1 if there is more than a single difference
+		if(difference > 1)
+			return 1;
+		else
+			return 0;
+	}
+	else
+		return 0;
+}
+
+// Find slot - edge slot of the face shared with a neighbour
+unsigned int DCStripifier::findSlot(unsigned int face, unsigned int neighbour) const
+{
+	const DCFaceAdjacency& adjacent = adjacency[face];
+
+	if(adjacent.neighbours[0] == neighbour)
+		return 0;
+	else if(adjacent.neighbours[1] == neighbour)
+		return 1;
+	else
+		return 2;
+}
+
+// Other vertex - the face's vertex off the edge it was entered through
+unsigned int DCStripifier::otherVertex(unsigned int face, unsigned int inSlot) const
+{
+	return model.getFace(face)->getData().v[adjacency[face].opposite[inSlot]];
+}
+
+// Common vertex - the face's vertex on both the entry and exit edges, i.e.
+// the vertex shared by the faces before and after it
+unsigned int DCStripifier::commonVertex(unsigned int face, unsigned int inSlot, unsigned int outSlot) const
+{
+	const DCFaceAdjacency& adjacent = adjacency[face];
+
+	return model.getFace(face)->getData().v[3 - adjacent.opposite[inSlot] - adjacent.opposite[outSlot]];
+}
+
+// Duplication check
+void DCStripifier::checkDuplication(DCMesh::Vertex* vert, DCMesh::Face* face, unsigned int texIndex, int faceVertIndex)
+{
+	if(vert->getData().set) // Texture coord has been set
+	{
+		if(vert->getData().texIndex != texIndex)
+		{
+			// Duplications are keyed by vertex id and texture id
+			unsigned long long key = ((unsigned long long)model.getVertexId(vert) << 32) | texIndex;
+			std::unordered_map<unsigned long long, unsigned int>::iterator dupeIt = duplicationIds.find(key);
+
+			// If the duplication has happened before
+			if(dupeIt != duplicationIds.end())
+			{
+				// Set the vertex to the same index
+				face->getData().v[faceVertIndex] = duplications[dupeIt->second].index;
+			}
+			// If the duplication is new
+			else
+			{
+				// Record duplication
+				vDuplication duplication;
+
+				duplication.vertIndex = model.getVertexId(vert);
+				duplication.texIndex = texIndex;
+				duplication.index = model.getNumVertices() + duplications.size();
+
+				duplicationIds[key] = duplications.size();
+				duplications.push_back(duplication);
+
+				// Alter face index
+				face->getData().v[faceVertIndex] = duplication.index;
+			}
+		}
+	}
+	else
+	{
+		vert->getData().set = 1;
+		vert->getData().texIndex = texIndex;
+	}
+}
+
+// Setters
+void DCStripifier::setSettings(const DCStripSettings& settings)
+{
+	this->settings = settings;
+}
+
+void DCStripifier::setStripGrowth(DCStripGrowth stripGrowth)
+{
+	this->stripGrowth = stripGrowth;
+}
+
+// Getters
+const DCStripSettings& DCStripifier::getSettings() const
+{
+	return settings;
+}
+
+const DCMesh& DCStripifier::getModel() const
+{
+	return model;
+}
+
+bool DCStripifier::isTextured() const
+{
+	return textured;
+}
+
+unsigned int DCStripifier::getNumDuplications() const
+{
+	return duplications.size();
+}
+
+const DCStripList& DCStripifier::getStrips() const
+{
+	return strips;
+}
+
+unsigned int DCStripifier::getNumStrips() const
+{
+	unsigned int numStrips = 0;
+
+	for(unsigned int i = 0; i < stripSpans.size(); ++i)
+		if(stripSpans[i].numFaces)
+			numStrips += 1;
+
+	return numStrips;
+}
+
+const std::vector<DCStripVertex>& DCStripifier::getVertices() const
+{
+	return vertices;
+}
+
+const std::vector<unsigned int>& DCStripifier::getIndices() const
+{
+	return indices;
+}
+
+const std::vector<unsigned int>& DCStripifier::getDrawCounts() const
+{
+	return drawCounts;
+}
+
+const std::vector<DCSubmesh>& DCStripifier::getSubmeshes() const
+{
+	return submeshes;
+}
+
+unsigned int DCStripifier::getNumJoinIndices() const
+{
+	return joinIndices;
+}
+
+unsigned int DCStripifier::getNumSwaps() const
+{
+	return swaps;
+}
+
+unsigned int DCStripifier::getNumStripsBeforeTunnelling() const
+{
+	return untunnelledStrips;
+}
+
+unsigned int DCStripifier::getNumRegionCuts() const
+{
+	return regionCuts;
+}
+
+unsigned int DCStripifier::getLargestRegion() const
+{
+	return largestRegion;
+}
+
+const std::vector<DCIndexRange>& DCStripifier::getPatchedRanges() const
+{
+	return patchedRanges;
+}
+
+const std::vector<DCStripSpan>& DCStripifier::getStripSpans() const
+{
+	return stripSpans;
+}
+
+const DCStripReport& DCStripifier::getReport() const
+{
+	return report;
+}
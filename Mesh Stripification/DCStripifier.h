@@ -0,0 +1,388 @@
+// ----------------------------------------
+// Class:		DCEL Stripifier
+// Description:	Device independent stripification - builds
+//				the DCEL, duplicates seam vertices and emits
+//				plain vertex and index arrays
+// ----------------------------------------
+
+#pragma once
+#ifndef DCSTRIPIFIER
+#define DCSTRIPIFIER
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <unordered_map>
+#include <vector>
+
+// DCEL - Half-Edge
+#include "DCEL/Mesh.h"
+#include "DCMeshData.h" // Personalised mesh data
+#include "DCFaceQueue.h" // Free faces by degree
+#include "DCVertexCache.h" // Cache simulation
+#include "DCIndexPacker.h" // Index width
+#include "DCStripReport.h" // Timings and statistics
+#include "DCStripList.h" // Strips as flat face ids
+
+// ----------------------------------------
+
+// Structure for vertex duplication
+struct vDuplication
+{
+	unsigned int vertIndex;
+	unsigned int texIndex;
+	unsigned int index; // Output vertex id
+};
+
+// Plain mesh description - filled by a loader, read by the stripifier
+struct DCMeshDef
+{
+	std::vector<float> positions; // x, y, z per vertex
+	std::vector<float> normals; // x, y, z per vertex
+	std::vector<float> texCoords; // s, t per texture coordinate
+	std::vector<unsigned int> faceVertices; // 3 vertex indices per face
+	std::vector<unsigned int> faceTexCoords; // 3 texture indices per face - empty if untextured
+	std::vector<bool> hiddenFaces; // Faces loaded hidden, shown by a later edit - empty if none
+	std::vector<unsigned int> faceMaterials; // Material per face - empty if one material
+};
+
+// Local mesh edit - face ids of the loaded DCEL. Faces are never destroyed;
+// removing hides a face and adding shows a hidden one
+struct DCMeshEdit
+{
+	std::vector<unsigned int> modified; // Visible faces whose strips are regrown
+	std::vector<unsigned int> removed; // Visible faces to hide
+	std::vector<unsigned int> added; // Hidden faces to show
+};
+
+// Indices of one material - contiguous, drawn by consecutive draws
+struct DCSubmesh
+{
+	unsigned int material;
+	DCIndexRange range;
+	unsigned int firstDraw;
+	unsigned int numDraws; // 1 unless strips are drawn separately
+};
+
+// Output vertex - one per original vertex, then one per duplication
+struct DCStripVertex
+{
+	float pos[3];
+	float normal[3];
+	float texCoord[2];
+};
+
+// Strip cut indices - restart a strip inside one draw
+#define DC_STRIP_CUT_32 0xFFFFFFFF
+#define DC_STRIP_CUT_16 0xFFFF
+
+// How strips are laid out in the index buffer
+enum DCStripOutput
+{
+	DC_OUTPUT_SEPARATE,	// One draw per strip
+	DC_OUTPUT_RESTART,	// One draw - strips separated by the strip cut index
+	DC_OUTPUT_STITCHED	// One draw - strips joined by degenerate triangles
+};
+
+// How strips are grown
+enum DCStripStrategy
+{
+	DC_STRATEGY_GREEDY,	// Lowest degree neighbour
+	DC_STRATEGY_CACHE,	// Neighbour with the most cached vertices, then lowest degree
+	DC_STRATEGY_LOOKAHEAD,	// Neighbour starting the best strip continuation over the next steps
+	DC_STRATEGY_TREE	// Fewest paths cut from a spanning tree of the face dual graph
+};
+
+// How multi-seed runs are compared - lowest wins
+enum DCSeedScore
+{
+	DC_SEED_SCORE_STRIPS,	// Strip count
+	DC_SEED_SCORE_INDICES,	// Indices of the strips drawn separately
+	DC_SEED_SCORE_ACMR	// Simulated cache misses per triangle - cacheType and cacheSize
+};
+
+// Stripification settings
+struct DCStripSettings
+{
+	bool stripify; // Strips or a plain triangle list
+	DCStripOutput output; // Strip layout
+	bool useTextures; // Duplicate vertices on texture seams
+	unsigned int maxLength; // Maximum faces per strip
+	DCIndexFormat indexFormat; // 16-bit chunks where possible, or 32-bit
+	bool reorderVertices; // Number vertices in first-use order
+
+	// Strip growth
+	DCStripStrategy strategy;
+	DCCacheType cacheType; // Simulated cache - cache strategy only
+	unsigned int cacheSize;
+	unsigned int lookAhead; // Look-ahead depth - look-ahead strategy only; 0 grows as greedy
+
+	// Tunnelling - merges finished strips
+	unsigned int tunnelIterations; // Tunnel searches - 0 disables tunnelling
+	unsigned int tunnelDepth; // Maximum non-strip edges along a tunnel
+
+	// Parallel stripification - faces split into one region per thread
+	unsigned int threads; // 1 stripifies every face on the calling thread
+
+	// Multi-seed stripification - independent runs over every face on all cores,
+	// each seeding equal degree faces in its own order; replaces regions
+	unsigned int seedRuns; // 1 runs once, in face id order
+	DCSeedScore seedScore; // Run kept
+
+	// Overdraw ordering - outward facing clusters of strips drawn first
+	bool orderOverdraw; // Kept only where it lowers the overdraw estimate
+	float overdrawThreshold; // Largest growth of the emitted indices' ACMR allowed by cluster splits, e.g. 1.05
+
+	DCStripSettings();
+};
+
+// Typedef for ease of use
+typedef Mesh<VertexData, HalfEdgeData, FaceData> DCMesh;
+
+// Region of a build over every face
+#define DC_NO_REGION 0xFFFFFFFF
+
+// Region of the faces regrown by an edit
+#define DC_EDIT_REGION 0xFFFFFFFE
+
+// Holes left by edits are compacted once they take more than 1 / DC_EDIT_HOLE_SHARE
+// of a submesh's indices
+#define DC_EDIT_HOLE_SHARE 4
+
+// Scratch state of a face during strip growth
+struct DCFaceState
+{
+	bool free; // Not yet in a strip
+	int degree; // Free neighbours
+};
+
+// Strip growth state - one per region or seed run when stripifying in parallel
+struct DCStripBuild
+{
+	unsigned int region; // Faces grown - DC_NO_REGION for every face
+	std::vector<DCFaceState> faces; // Copied from the model, so builds over the same faces run at once
+	std::vector<unsigned int> seedOrder; // Order equal degree faces are seeded in - empty for face id order
+	DCFaceQueue freeFaces; // Free faces - bucketed by degree
+	DCVertexCache cache; // Cache strategy - simulated cache
+	std::vector<bool> lookTaken; // Look-ahead strategy - faces taken by the path being scored
+	std::vector<unsigned int> treeNodes; // Tree strategy - tree node of each face, DC_NO_FACE if none
+	DCStripList strips; // Strips grown - stored as face indexes
+
+	DCStripBuild();
+};
+
+// Edges of one face - slots in half-edge order; built once per load so strip
+// growth and emission read neighbours without walking the DCEL
+struct DCFaceAdjacency
+{
+	unsigned int neighbours[3]; // DC_NO_FACE on a boundary
+	unsigned char slots[3]; // Slot of the shared edge in the neighbour
+	unsigned char opposite[3]; // Position of the vertex off the edge, in the face's vertices
+	unsigned char seams; // Bit per slot - edge on a texture or material seam
+};
+
+// Tables read by strip growth - see DCStripBuilder.h
+struct DCStripContext;
+
+// Strip growth over a build's queued faces - a DCStripBuilder instantiation's stripFreeFaces
+typedef void (*DCStripGrowth)(const DCStripContext& context, DCStripBuild& build);
+
+// Emitted strip - the strip of the same index in the strip list; edits
+// replace it by overwriting its range with a hole
+struct DCStripSpan
+{
+	unsigned int numFaces; // 0 once replaced
+	DCIndexRange range; // Exact indices of the strip, with the joins before it
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+class DCStripifier
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	// Model (DCEL)
+	DCMesh model;
+
+	// Settings
+	DCStripSettings settings;
+	DCStripGrowth stripGrowth; // NULL to grow with the settings' strategy
+
+	// Texture Coordinates
+	bool textured;
+	std::vector<float> texCoords;
+
+	// Vertex duplications - in creation order, found by (vertex id, texture id)
+	std::vector<vDuplication> duplications;
+	std::unordered_map<unsigned long long, unsigned int> duplicationIds;
+
+	// Output vertex id of each DCEL vertex
+	std::vector<unsigned int> vertexIds;
+
+	// Adjacency - one entry per face
+	std::vector<DCFaceAdjacency> adjacency;
+
+	// Strips - stored as face indexes; once emitted, strip i is drawn by stripSpans[i]
+	DCStripList strips;
+
+	// Cache strategy - faces around each output vertex
+	std::vector<unsigned int> vertexFaceStart;
+	std::vector<unsigned int> vertexFaces;
+
+	// Parallel stripification - region of each face, empty when serial
+	std::vector<unsigned int> faceRegions;
+	unsigned int regionCuts; // Seam-free edges between regions
+	unsigned int largestRegion; // Faces in the largest region
+
+	// Tunnelling - strip links and seam-free neighbours, two and three per face
+	std::vector<unsigned int> tunnelLinks;
+	std::vector<unsigned int> tunnelNeighbours;
+	std::vector<unsigned int> tunnelStamps; // Search that last reached each face
+	std::vector<unsigned int> tunnelParents;
+	unsigned int tunnelSearch;
+	unsigned int untunnelledStrips; // Strip count before tunnelling
+
+	// Incremental edits - emitted strips, in index stream order after a build; the strip of each face
+	std::vector<DCStripSpan> stripSpans;
+	std::vector<unsigned int> faceSpans; // DC_NO_FACE if hidden
+	std::vector<unsigned int> holeSpans; // Replaced strips whose ranges can take regrown strips
+	unsigned int tailSpan; // Strip ending the index stream - appended strips join it
+	DCStripBuild editBuild; // Queue sized once per build
+	std::vector<DCIndexRange> patchedRanges; // Index ranges rewritten by the last edit
+
+	// Report of the last load and build
+	DCStripReport report;
+
+	// Output
+	std::vector<DCStripVertex> vertices;
+	std::vector<unsigned int> indices;
+	std::vector<unsigned int> drawCounts; // Indices per draw call
+	std::vector<DCSubmesh> submeshes; // In index stream order - one per material after a build
+	unsigned int joinIndices; // Indices added to join strips into one draw
+	unsigned int swaps; // Swap indices added inside strips
+
+	// Methods ----------------------------
+	// Setup output arrays
+	void setupVertices();
+	void setupIndexBuffer();
+	void setupStripification();
+	void joinRestart(); // Strips of each submesh into one restart stream
+	void joinStitched(); // Strips of each submesh into one continuous strip
+	void groupStrips(); // Strips in material order
+	void beginSubmesh(unsigned int material);
+	void reorderOutputVertices(); // Vertices into first-use order
+	void resetFaces(); // Every visible face free
+	void emitStrips(); // Strips into the index array, one submesh per run of a material
+	unsigned int emitStrip(const unsigned int* strip, unsigned int numFaces, std::vector<unsigned int>& indexVec); // Returns the swaps added
+	void setupEdits();
+	void setupAdjacency(const DCMeshDef& meshDef);
+
+	// Strip creation functions - growth itself is a DCStripBuilder instantiation
+	void growStrips(DCStripBuild& build); // Strips over the build's free faces
+	void stripFreeFaces(DCStripBuild& build); // Strips until the build's queue is empty
+	bool isTextureSeam(DCMesh::Face* face1, DCMesh::Face* face2); // Adjacency setup only
+	bool isInRegion(const DCStripBuild& build, unsigned int face) const;
+
+	// Parallel stripification
+	void partitionFaces(unsigned int numRegions);
+	unsigned int findContactRegion(const std::vector<unsigned int>& faces, unsigned int exclude, std::vector<unsigned int>& contacts) const; // Region sharing most edges with the faces
+	void balanceRegions(unsigned int numRegions); // Boundary faces from larger regions to smaller neighbours
+	bool isRegionBridge(unsigned int face) const; // Region may split without the face
+
+	// Multi-seed stripification
+	void growSeedRuns(DCStripBuild& build); // The best run's strips into the build
+	void runSeeds(std::vector<DCStripBuild>* runs, std::vector<double>* scores, unsigned int first, unsigned int step); // Every step-th run from first
+	double scoreStrips(const DCStripList& strips);
+
+	// Cache strategy
+	void setupVertexFaces();
+
+	// Overdraw ordering
+	void orderStrips();
+
+	// Tunnelling
+	void tunnelStrips();
+	bool findTunnel(unsigned int face); // Applies the first valid tunnel from a strip end
+	bool applyTunnel(const std::vector<unsigned int>& path);
+	void flipTunnel(const std::vector<unsigned int>& path, bool apply);
+	void addLink(unsigned int face1, unsigned int face2);
+	void removeLink(unsigned int face1, unsigned int face2);
+	bool isLinked(unsigned int face1, unsigned int face2) const;
+	unsigned int nextLink(unsigned int face, unsigned int prev) const;
+	unsigned int stripLength(unsigned int face) const; // 0 if the face is on a cycle
+	void rebuildStrips();
+
+	// Index searching/creation - strip faces enter and leave through edge slots
+	unsigned int findSlot(unsigned int face, unsigned int neighbour) const;
+	unsigned int otherVertex(unsigned int face, unsigned int inSlot) const; // Off the entry edge
+	unsigned int commonVertex(unsigned int face, unsigned int inSlot, unsigned int outSlot) const; // On both edges
+
+	// Duplication check
+	void checkDuplication(DCMesh::Vertex* vert, DCMesh::Face* face, unsigned int texIndex, int faceVertIndex);
+
+	// Report
+	void fillReport(); // Output counts, strip lengths and memory
+	void sampleMemory();
+
+	// Incremental edits
+	void releaseStrip(unsigned int span, std::vector<unsigned int>& faces); // Faces of the strip to faces
+	bool placeStrip(const unsigned int* strip, unsigned int numFaces, const std::vector<unsigned int>& stripIndices); // Into the smallest hole it fits
+	void appendStrip(const unsigned int* strip, unsigned int numFaces, const std::vector<unsigned int>& stripIndices);
+	void compactStrips(); // Every strip emitted again, one submesh per material
+	unsigned int findSubmesh(unsigned int index) const; // Submesh whose range holds the index
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCStripifier(const DCStripSettings& settings = DCStripSettings());
+	~DCStripifier();
+
+	// Loads mesh data into the DCEL - duplicates seam vertices and sets face degrees
+	void loadMesh(const DCMeshDef& meshDef);
+
+	// Builds the vertex and index arrays - one submesh per material
+	void build();
+
+	// Regrows only the strips touching the edited faces and patches the index
+	// array in place - replaced strips become holes, new strips fill the smallest
+	// hole of their material they fit, or are appended, joining the last submesh
+	// if it has their material or starting new ones. A submesh whose holes pass
+	// DC_EDIT_HOLE_SHARE, or twice as many submeshes as materials, compacts the
+	// index array, one submesh per material
+	void editMesh(const DCMeshEdit& edit);
+
+	// Takes built output saved earlier, e.g. by a cache - the model is left empty
+	void restoreOutput(std::vector<DCStripVertex>& vertices, std::vector<unsigned int>& indices, std::vector<unsigned int>& drawCounts,
+		std::vector<DCSubmesh>& submeshes, std::vector<DCStripSpan>& stripSpans, bool textured);
+
+	// Setters
+	void setSettings(const DCStripSettings& settings);
+	void setStripGrowth(DCStripGrowth stripGrowth); // Replaces the strategy's builder, e.g. to compare policies
+
+	// Getters
+	const DCStripSettings& getSettings() const;
+	const DCMesh& getModel() const;
+	bool isTextured() const;
+	unsigned int getNumDuplications() const;
+	const DCStripList& getStrips() const; // Strips replaced by edits are kept, with empty spans
+	unsigned int getNumStrips() const; // Strips drawn
+	const std::vector<DCStripVertex>& getVertices() const;
+	const std::vector<unsigned int>& getIndices() const;
+	const std::vector<unsigned int>& getDrawCounts() const;
+	const std::vector<DCSubmesh>& getSubmeshes() const;
+	unsigned int getNumJoinIndices() const;
+	unsigned int getNumSwaps() const;
+	unsigned int getNumStripsBeforeTunnelling() const;
+	unsigned int getNumRegionCuts() const;
+	unsigned int getLargestRegion() const; // Faces, 0 without regions
+	const std::vector<DCIndexRange>& getPatchedRanges() const; // In index order, disjoint - the whole array after a compaction
+	const std::vector<DCStripSpan>& getStripSpans() const;
+	const DCStripReport& getReport() const;
+};
+// ----------------------------------------
+
+#endif
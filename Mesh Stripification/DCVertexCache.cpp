@@ -0,0 +1,100 @@
+// ----------------------------------------
+// Class: DCEL Vertex Cache source
+// ----------------------------------------
+
+// Include header
+#include "DCVertexCache.h"
+
+// Constructor
+DCVertexCache::DCVertexCache(DCCacheType type, unsigned int size)
+{
+	this->type = type;
+	this->size = size > 0 ? size : 1;
+
+	entries.reserve(this->size);
+	clear();
+}
+
+// Destructor
+DCVertexCache::~DCVertexCache()
+{
+	// Empty
+}
+
+// Clear
+void DCVertexCache::clear()
+{
+	entries.clear();
+	hits = 0;
+	misses = 0;
+}
+
+// Find
+int DCVertexCache::find(unsigned int vertex) const
+{
+	for(unsigned int i = 0; i < entries.size(); ++i)
+		if(entries[i] == vertex)
+			return i;
+
+	return -1;
+}
+
+// Access - simulate transforming a vertex
+bool DCVertexCache::access(unsigned int vertex)
+{
+	int position = find(vertex);
+
+	// Hit
+	if(position >= 0)
+	{
+		// LRU - move to the front
+		if(type == DC_CACHE_LRU)
+		{
+			entries.erase(entries.begin() + position);
+			entries.insert(entries.begin(), vertex);
+		}
+
+		hits += 1;
+		return true;
+	}
+
+	// Miss - insert at the front, drop the oldest
+	if(entries.size() == size)
+		entries.pop_back();
+
+	entries.insert(entries.begin(), vertex);
+
+	misses += 1;
+	return false;
+}
+
+// Getters
+bool DCVertexCache::contains(unsigned int vertex) const
+{
+	return find(vertex) >= 0;
+}
+
+const std::vector<unsigned int>& DCVertexCache::getEntries() const
+{
+	return entries;
+}
+
+DCCacheType DCVertexCache::getType() const
+{
+	return type;
+}
+
+unsigned int DCVertexCache::getSize() const
+{
+	return size;
+}
+
+unsigned int DCVertexCache::getHits() const
+{
+	return hits;
+}
+
+unsigned int DCVertexCache::getMisses() const
+{
+	return misses;
+}
@@ -0,0 +1,72 @@
+// ----------------------------------------
+// Class:		DCEL Vertex Cache
+// Description:	Post-transform vertex cache simulation
+// ----------------------------------------
+
+#pragma once
+#ifndef DCVERTEXCACHE
+#define DCVERTEXCACHE
+
+// ----------------------------------------
+// INCLUDES
+// ----------------------------------------
+// STL
+#include <vector>
+
+// ----------------------------------------
+
+// Cache replacement policy
+enum DCCacheType
+{
+	DC_CACHE_FIFO,	// Oldest entry is replaced - hits do not refresh
+	DC_CACHE_LRU	// Least recently used entry is replaced
+};
+
+// ----------------------------------------
+// CLASS INTERFACE DESIGN
+// ----------------------------------------
+// Holds at most size vertex indices. Caches are small (8 - 32 entries)
+// so entries are kept in a flat array ordered newest first.
+class DCVertexCache
+{
+// ----------------------------------------
+private:
+	// Attributes -------------------------
+	DCCacheType type;
+	unsigned int size;
+
+	// Entries - newest first
+	std::vector<unsigned int> entries;
+
+	// Counters
+	unsigned int hits;
+	unsigned int misses;
+
+	// Methods ----------------------------
+	// Position of a vertex in entries - -1 if not cached
+	int find(unsigned int vertex) const;
+
+// ----------------------------------------
+public:
+
+	// Constructor / Destructor
+	DCVertexCache(DCCacheType type = DC_CACHE_FIFO, unsigned int size = 16);
+	~DCVertexCache();
+
+	// Empties the cache and resets the counters
+	void clear();
+
+	// Transforms a vertex - returns true on a cache hit
+	bool access(unsigned int vertex);
+
+	// Getters
+	bool contains(unsigned int vertex) const;
+	const std::vector<unsigned int>& getEntries() const;
+	DCCacheType getType() const;
+	unsigned int getSize() const;
+	unsigned int getHits() const;
+	unsigned int getMisses() const;
+};
+// ----------------------------------------
+
+#endif
@@ -80,6 +80,21 @@ void JStrip::setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode)
 		count += 3;
 	}
 
+	// Pack indices to 16-bit in place when every vertex can be addressed
+	UINT indexSize = sizeof(DWORD);
+	indexFormat = DXGI_FORMAT_R32_UINT;
+
+	if(meshData.N <= 0x10000)
+	{
+		WORD* shortIndices = (WORD*)indices;
+
+		for(int i = 0; i < meshData.n * 3; ++i)
+			shortIndices[i] = (WORD)indices[i];
+
+		indexSize = sizeof(WORD);
+		indexFormat = DXGI_FORMAT_R16_UINT;
+	}
+
 	D3D11_BUFFER_DESC vertexDesc;
 	D3D11_SUBRESOURCE_DATA vertexData;
 
@@ -105,7 +120,7 @@ void JStrip::setupBuffers(ID3D11Device *device, ID3DBlob *vsBytecode)
 	ZeroMemory(&indexData, sizeof(D3D11_SUBRESOURCE_DATA));
 
 	indexDesc.Usage = D3D11_USAGE_IMMUTABLE;
-	indexDesc.ByteWidth = sizeof(DWORD) * (meshData.n * 3);
+	indexDesc.ByteWidth = indexSize * (meshData.n * 3);
 	indexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 	indexData.pSysMem = indices;
 
@@ -134,7 +149,7 @@ void JStrip::render(ID3D11DeviceContext *context)
 	UINT vertexOffsets[] = {0};
 
 	context->IASetVertexBuffers(0, 1, vertexBuffers, vertexStrides, vertexOffsets);
-	context->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	context->IASetIndexBuffer(indexBuffer, indexFormat, 0);
 
 	// Set primitive topology for IA
 	context->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -22,6 +22,7 @@ class JStrip : public CGBaseModel
 private:
 	CGPolyMesh*						meshCopy;
 	CGBaseMeshDefStruct				meshData;
+	DXGI_FORMAT						indexFormat; // 16-bit when every vertex can be addressed
 
 	ID3D11ShaderResourceView		*textureResourceView;
 	ID3D11SamplerState				*sampler;
@@ -29,6 +29,7 @@ CGBasicTerrain::CGBasicTerrain(ID3D11Device *device, ID3DBlob *vsBytecode, DWORD
 	inputLayout = nullptr;
 	w = 0;
 	h = 0;
+	indexFormat = DXGI_FORMAT_R32_UINT;
 
 	try
 	{
@@ -118,6 +119,22 @@ CGBasicTerrain::CGBasicTerrain(ID3D11Device *device, ID3DBlob *vsBytecode, DWORD
 		}
 
 
+		// Pack indices to 16-bit in place when every vertex can be addressed - each
+		// WORD is written below the DWORD it is read from
+		UINT indexSize = sizeof(DWORD);
+
+		if (w * h <= 0x10000) {
+
+			WORD *sptr = (WORD*)indices;
+
+			for (DWORD k=0; k<(w-1) * (h-1) * 6; ++k)
+				sptr[k] = (WORD)indices[k];
+
+			indexFormat = DXGI_FORMAT_R16_UINT;
+			indexSize = sizeof(WORD);
+		}
+
+
 		// Setup vertex buffer
 		D3D11_BUFFER_DESC vertexDesc;
 		D3D11_SUBRESOURCE_DATA vertexData;
@@ -144,7 +161,7 @@ CGBasicTerrain::CGBasicTerrain(ID3D11Device *device, ID3DBlob *vsBytecode, DWORD
 		ZeroMemory(&indexData, sizeof(D3D11_SUBRESOURCE_DATA));
 
 		indexDesc.Usage = D3D11_USAGE_IMMUTABLE;
-		indexDesc.ByteWidth = sizeof(DWORD) * (w-1) * (h-1) * 6;
+		indexDesc.ByteWidth = indexSize * (w-1) * (h-1) * 6;
 		indexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		indexData.pSysMem = indices;
 
@@ -207,7 +224,7 @@ void CGBasicTerrain::render(ID3D11DeviceContext *context) {
 	UINT vertexOffsets[] = {0};
 
 	context->IASetVertexBuffers(0, 1, vertexBuffers, vertexStrides, vertexOffsets);
-	context->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	context->IASetIndexBuffer(indexBuffer, indexFormat, 0);
 
 	// Set primitive topology for IA
 	context->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -9,6 +9,7 @@
 class CGBasicTerrain : public CGBaseModel {
 
 	DWORD					w, h; // dimensions of the terrain on the (x, z) plane
+	DXGI_FORMAT				indexFormat; // 16-bit when every vertex can be addressed
 
 public:
 
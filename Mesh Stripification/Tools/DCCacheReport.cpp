@@ -0,0 +1,164 @@
+// ----------------------------------------
+// Tool:		DCCacheReport
+// Description:	Vertex cache quality report - ACMR and ATVR
+//				of the triangle list, greedy strips and
+//				cache-aware strips for each model
+//
+// Usage:		DCCacheReport [options] model.obj [model.obj ...]
+//				-fifo			FIFO caches only
+//				-lru			LRU caches only
+//				-sizes a,b,..	Cache sizes (default 8,16,32)
+//
+// e.g.			DCCacheReport Resources/Models/*.obj
+//
+// Builds without Direct X - compile with the library sources, i.e.
+// every DC*.cpp except DCStripification.cpp
+// ----------------------------------------
+
+// INCLUDES
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DCCacheMetrics.h"
+#include "DCObjLoader.h"
+#include "DCStripifier.h"
+
+// Ensure correct namespace use
+using namespace std;
+
+// Print one report row
+static void printRow(const string& model, const string& mode, const DCCacheReport& report)
+{
+	cout << left << setw(24) << model << setw(10) << mode
+		<< setw(5) << (report.cacheType == DC_CACHE_FIFO ? "FIFO" : "LRU") << right << setw(4) << report.cacheSize
+		<< setw(9) << report.indices << setw(8) << report.strips << setw(8) << report.swaps
+		<< fixed << setprecision(3) << setw(8) << report.acmr << setw(8) << report.atvr
+		<< setw(8) << report.fetchLines << setprecision(1) << setw(9) << report.fetchDistance << endl;
+}
+
+// Stripify a mesh definition with the given settings
+static void run(const DCMeshDef& meshDef, const DCStripSettings& settings, DCStripifier& stripifier)
+{
+	stripifier.setSettings(settings);
+	stripifier.loadMesh(meshDef);
+	stripifier.build();
+}
+
+// Print usage
+static void usage()
+{
+	cerr << "Usage: DCCacheReport [-fifo | -lru] [-sizes a,b,...] model.obj [model.obj ...]" << endl;
+}
+
+// Main
+int main(int argc, char** argv)
+{
+	vector<DCCacheType> types;
+	vector<unsigned int> sizes;
+	vector<string> models;
+
+	types.push_back(DC_CACHE_FIFO);
+	types.push_back(DC_CACHE_LRU);
+
+	// Parse arguments
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-fifo"))
+			types.assign(1, DC_CACHE_FIFO);
+		else if(!strcmp(argv[i], "-lru"))
+			types.assign(1, DC_CACHE_LRU);
+		else if(!strcmp(argv[i], "-sizes") && i + 1 < argc)
+		{
+			stringstream list(argv[++i]);
+			string size;
+
+			while(getline(list, size, ','))
+				sizes.push_back(atoi(size.c_str()));
+		}
+		else if(argv[i][0] == '-')
+		{
+			usage();
+			return 1;
+		}
+		else
+			models.push_back(argv[i]);
+	}
+
+	if(models.empty())
+	{
+		usage();
+		return 1;
+	}
+
+	if(sizes.empty())
+	{
+		sizes.push_back(8);
+		sizes.push_back(16);
+		sizes.push_back(32);
+	}
+
+	// Keep the library's progress output off the report
+	cerr.setstate(ios::failbit);
+
+	cout << left << setw(24) << "model" << setw(10) << "mode" << setw(9) << "cache"
+		<< right << setw(9) << "indices" << setw(8) << "strips" << setw(8) << "swaps"
+		<< setw(8) << "ACMR" << setw(8) << "ATVR" << setw(8) << "lines" << setw(9) << "distance" << endl;
+
+	int result = 0;
+
+	for(unsigned int m = 0; m < models.size(); ++m)
+	{
+		DCMeshDef meshDef;
+
+		try
+		{
+			DCObjLoader::load(models[m], meshDef);
+		}
+		catch(const std::exception& e)
+		{
+			cout << models[m] << ": " << e.what() << endl;
+			result = 1;
+			continue;
+		}
+
+		// Model name without its directory
+		string name = models[m].substr(models[m].find_last_of("/\\") + 1);
+
+		// Triangle list and greedy strips do not depend on the cache
+		DCStripSettings listSettings;
+		listSettings.stripify = false;
+
+		DCStripifier list;
+		run(meshDef, listSettings, list);
+
+		DCStripifier greedy;
+		run(meshDef, DCStripSettings(), greedy);
+
+		for(unsigned int t = 0; t < types.size(); ++t)
+		{
+			for(unsigned int s = 0; s < sizes.size(); ++s)
+			{
+				printRow(name, "list", DCCacheMetrics::measure(list, types[t], sizes[s]));
+				printRow(name, "greedy", DCCacheMetrics::measure(greedy, types[t], sizes[s]));
+
+				// Cache-aware strips grown for this cache
+				DCStripSettings cacheSettings;
+				cacheSettings.strategy = DC_STRATEGY_CACHE;
+				cacheSettings.cacheType = types[t];
+				cacheSettings.cacheSize = sizes[s];
+
+				DCStripifier cached;
+				run(meshDef, cacheSettings, cached);
+
+				printRow(name, "cache", DCCacheMetrics::measure(cached, types[t], sizes[s]));
+			}
+		}
+	}
+
+	return result;
+}
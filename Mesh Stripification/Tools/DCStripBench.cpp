@@ -0,0 +1,144 @@
+// ----------------------------------------
+// Tool:		DCStripBench
+// Description:	Strip growth benchmark - times each strip
+//				builder instantiation on the same mesh and
+//				compares the strips they grow
+//
+// Usage:		DCStripBench [options] model.obj
+//				-repeat N		Builds per instantiation, the fastest is kept (default 5)
+//				-notex			Ignore texture seams
+//				-maxlength N	Maximum faces per strip
+//				-cache N		Simulated cache of N vertices (default 16)
+//				-lru			Simulate an LRU cache rather than FIFO
+//				-lookahead K	Look-ahead depth (default 2)
+//
+// e.g.			DCStripBench -repeat 10 Resources/Models/chair2.obj
+//
+// Builds without Direct X - compile with the library sources, i.e.
+// every DC*.cpp except DCStripification.cpp
+// ----------------------------------------
+
+// INCLUDES
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "DCCacheMetrics.h"
+#include "DCObjLoader.h"
+#include "DCStripBuilder.h"
+#include "DCStripTree.h"
+#include "DCStripifier.h"
+
+// Ensure correct namespace use
+using namespace std;
+
+// Instantiation under test
+struct BenchGrowth
+{
+	const char* name;
+	DCStripGrowth growth;
+};
+
+// Instantiations - one per strategy, and the cache strategy without its cached seeds
+static const BenchGrowth growths[] =
+{
+	{"greedy", &DCStripBuilder<DCLowestDegreeSeed, DCDegreeNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces},
+	{"cache", &DCStripBuilder<DCCachedSeed, DCCachedNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces},
+	{"cache-next", &DCStripBuilder<DCLowestDegreeSeed, DCCachedNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces},
+	{"lookahead", &DCStripBuilder<DCLowestDegreeSeed, DCLookAheadNeighbour, DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces},
+	{"tree", &DCStripTree<DCAdjacencySeams, DCMaxLengthTermination>::stripFreeFaces}
+};
+
+// Print usage
+static void usage()
+{
+	cerr << "Usage: DCStripBench [-repeat N] [-notex] [-maxlength N] [-cache N] [-lru] [-lookahead K] model.obj" << endl;
+}
+
+// Main
+int main(int argc, char** argv)
+{
+	DCStripSettings settings;
+	settings.cacheSize = 16;
+	settings.lookAhead = 2;
+
+	unsigned int repeat = 5;
+	string model;
+
+	// Parse arguments
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-repeat") && i + 1 < argc)
+			repeat = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-notex"))
+			settings.useTextures = false;
+		else if(!strcmp(argv[i], "-maxlength") && i + 1 < argc)
+			settings.maxLength = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-cache") && i + 1 < argc)
+			settings.cacheSize = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-lru"))
+			settings.cacheType = DC_CACHE_LRU;
+		else if(!strcmp(argv[i], "-lookahead") && i + 1 < argc)
+			settings.lookAhead = atoi(argv[++i]);
+		else if(argv[i][0] == '-' || !model.empty())
+		{
+			usage();
+			return 1;
+		}
+		else
+			model = argv[i];
+	}
+
+	if(model.empty() || repeat < 1 || settings.maxLength < 1)
+	{
+		usage();
+		return 1;
+	}
+
+	DCMeshDef meshDef;
+
+	try
+	{
+		DCObjLoader::load(model, meshDef);
+	}
+	catch(const std::exception& e)
+	{
+		cerr << model << ": " << e.what() << endl;
+		return 1;
+	}
+
+	// Keep the library's progress output off the table
+	cerr.setstate(ios::failbit);
+
+	cout << model << ": " << meshDef.faceVertices.size() / 3 << " faces, best of " << repeat << " builds" << endl;
+	cout << left << setw(12) << "builder" << right << setw(11) << "grow (ms)" << setw(9) << "strips"
+		<< setw(8) << "swaps" << setw(9) << "indices" << setw(8) << "ACMR" << endl;
+
+	for(unsigned int i = 0; i < sizeof(growths) / sizeof(growths[0]); ++i)
+	{
+		DCStripifier stripifier(settings);
+		stripifier.setStripGrowth(growths[i].growth);
+		stripifier.loadMesh(meshDef);
+
+		// Strip growth time of the fastest build - every build grows the same strips
+		double best = 0;
+
+		for(unsigned int r = 0; r < repeat; ++r)
+		{
+			stripifier.build();
+
+			if(r == 0 || stripifier.getReport().stripTime < best)
+				best = stripifier.getReport().stripTime;
+		}
+
+		DCCacheReport cache = DCCacheMetrics::measure(stripifier, settings.cacheType, settings.cacheSize);
+
+		cout << left << setw(12) << growths[i].name << right << fixed << setprecision(2) << setw(11) << best * 1000
+			<< setw(9) << stripifier.getReport().strips << setw(8) << stripifier.getNumSwaps()
+			<< setw(9) << stripifier.getIndices().size() << setprecision(3) << setw(8) << cache.acmr << endl;
+	}
+
+	return 0;
+}
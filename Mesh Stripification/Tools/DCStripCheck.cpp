@@ -0,0 +1,164 @@
+// ----------------------------------------
+// Tool:		DCStripCheck
+// Description:	Headless layout check - builds each model in
+//				every output layout and checks the expanded
+//				triangles are the input faces, winding kept
+//
+// Usage:		DCStripCheck [models...]
+//				With no models the cube, chair and chair2 in
+//				Resources/Models are checked
+//
+// e.g.			DCStripCheck Resources/Models/chair2.obj
+//
+// Builds without Direct X - compile with the library sources, i.e.
+// every DC*.cpp except DCStripification.cpp. Returns non-zero if any
+// layout loses, adds or flips a face.
+// ----------------------------------------
+
+// INCLUDES
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "DCIndexStream.h"
+#include "DCObjLoader.h"
+#include "DCStripifier.h"
+
+// Ensure correct namespace use
+using namespace std;
+
+// Triangle by corner positions - rotated to start at the smallest
+// corner, so rotations match and flipped windings don't
+typedef vector<float> CheckTriangle;
+
+// Layout under test
+struct CheckLayout
+{
+	const char* name;
+	DCStripOutput output;
+};
+
+static const CheckLayout layouts[] =
+{
+	{"separate", DC_OUTPUT_SEPARATE},
+	{"restart", DC_OUTPUT_RESTART},
+	{"stitched", DC_OUTPUT_STITCHED}
+};
+
+static const char* defaultModels[] =
+{
+	"Resources/Models/cube.obj",
+	"Resources/Models/chair.obj",
+	"Resources/Models/chair2.obj"
+};
+
+// Canonical triangle from three corner positions
+static CheckTriangle makeTriangle(const float* a, const float* b, const float* c)
+{
+	const float* corners[3] = {a, b, c};
+	unsigned int first = 0;
+
+	for(unsigned int i = 1; i < 3; ++i)
+	{
+		if(lexicographical_compare(corners[i], corners[i] + 3, corners[first], corners[first] + 3))
+			first = i;
+	}
+
+	CheckTriangle triangle;
+	triangle.reserve(9);
+
+	for(unsigned int i = 0; i < 3; ++i)
+		triangle.insert(triangle.end(), corners[(first + i) % 3], corners[(first + i) % 3] + 3);
+
+	return triangle;
+}
+
+// Checks one layout, returns the number of faces lost, added or flipped
+static unsigned int checkLayout(const DCMeshDef& meshDef, DCStripOutput output)
+{
+	DCStripSettings settings;
+	settings.output = output;
+
+	DCStripifier stripifier(settings);
+	stripifier.loadMesh(meshDef);
+	stripifier.build();
+
+	// Input faces - hidden faces are never drawn
+	map<CheckTriangle, int> faces;
+
+	for(unsigned int i = 0; i < meshDef.faceVertices.size() / 3; ++i)
+	{
+		if(!meshDef.hiddenFaces.empty() && meshDef.hiddenFaces[i])
+			continue;
+
+		const unsigned int* v = &meshDef.faceVertices[i * 3];
+		++faces[makeTriangle(&meshDef.positions[v[0] * 3], &meshDef.positions[v[1] * 3], &meshDef.positions[v[2] * 3])];
+	}
+
+	// Drawn triangles - separate draws expand as their own strips
+	vector<unsigned int> triangles;
+	DCIndexStream::expandStrips(stripifier.getIndices(), stripifier.getDrawCounts(), DC_STRIP_CUT_32, triangles);
+
+	const vector<DCStripVertex>& vertices = stripifier.getVertices();
+
+	for(unsigned int i = 0; i < triangles.size(); i += 3)
+		--faces[makeTriangle(vertices[triangles[i]].pos, vertices[triangles[i + 1]].pos, vertices[triangles[i + 2]].pos)];
+
+	unsigned int mismatched = 0;
+
+	for(map<CheckTriangle, int>::const_iterator it = faces.begin(); it != faces.end(); ++it)
+		mismatched += it->second < 0 ? -it->second : it->second;
+
+	return mismatched;
+}
+
+// Main
+int main(int argc, char** argv)
+{
+	vector<string> models(argv + 1, argv + argc);
+
+	if(models.empty())
+		models.assign(defaultModels, defaultModels + sizeof(defaultModels) / sizeof(defaultModels[0]));
+
+	unsigned int failures = 0;
+
+	for(unsigned int m = 0; m < models.size(); ++m)
+	{
+		DCMeshDef meshDef;
+
+		try
+		{
+			DCObjLoader::load(models[m], meshDef);
+		}
+		catch(const std::exception& e)
+		{
+			cerr << models[m] << ": " << e.what() << endl;
+			++failures;
+			continue;
+		}
+
+		// Keep the library's progress output off the table
+		cerr.setstate(ios::failbit);
+
+		for(unsigned int i = 0; i < sizeof(layouts) / sizeof(layouts[0]); ++i)
+		{
+			const unsigned int mismatched = checkLayout(meshDef, layouts[i].output);
+
+			cout << models[m] << " " << layouts[i].name << ": ";
+
+			if(mismatched)
+			{
+				cout << "FAILED, " << mismatched << " faces mismatched" << endl;
+				++failures;
+			}
+			else
+				cout << "ok" << endl;
+		}
+
+		cerr.clear();
+	}
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,732 @@
+// ----------------------------------------
+// Tool:		DCStripify
+// Description:	Headless command-line stripifier
+//
+// Usage:		DCStripify [options] model.obj [output.dcs]
+//				-list			Triangle list, no strips
+//				-restart		One draw, strips split by the strip cut index
+//				-stitch			One draw, strips joined by degenerate triangles
+//				-notex			Ignore texture seams
+//				-wide			Keep 32-bit indices
+//				-noreorder		Keep vertices in file order
+//				-maxlength N	Maximum faces per strip
+//				-cache N		Grow strips around a simulated cache of N vertices
+//				-lru			Simulate an LRU cache rather than FIFO
+//				-lookahead K	Grow strips by scoring K steps ahead
+//				-tree			Cut strips from a spanning tree of the face dual graph
+//				-tunnel N		Merge strips with up to N tunnel searches
+//				-tunneldepth D	Maximum non-strip edges along a tunnel
+//				-threads N		Stripify N regions in parallel
+//				-seeds N		Keep the best of N seed orders, run in parallel
+//				-seedscore S	Best seed run by strips, indices or acmr (default strips)
+//				-meshlets V T	Also cut meshlets of at most V vertices, T triangles
+//				-overdraw T		Order strip clusters for overdraw, ACMR growth up to T
+//				-edit N			Remove then restore a patch of N faces incrementally
+//				-cachedir DIR	Load the strips from DIR, or build and save them there
+//				-verify			With -cachedir, compare the cached strips with a fresh build
+//				-json FILE		Write the stage timings, strip lengths and memory as JSON
+//				-autotune		Pick the strip growth settings and save them to model.obj.dctune
+//				-stream W		Stripify out of core, faces in file order through a window of W faces;
+//								one draw, vertex positions only, in file order - needs -restart or
+//								-stitch, -notex and -noreorder
+//
+// Builds without Direct X - compile with the library sources, i.e.
+// every DC*.cpp except DCStripification.cpp, e.g.
+//				g++ -O2 -I.. <library sources> DCStripify.cpp
+// ----------------------------------------
+
+// INCLUDES
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "DCCacheMetrics.h"
+#include "DCIndexPacker.h"
+#include "DCIndexStream.h"
+#include "DCAutotuner.h"
+#include "DCMeshletBuilder.h"
+#include "DCObjLoader.h"
+#include "DCOverdraw.h"
+#include "DCObjStream.h"
+#include "DCStripCache.h"
+#include "DCStripifier.h"
+#include "DCStreamStripifier.h"
+
+// Ensure correct namespace use
+using namespace std;
+
+// Output file tag
+static const char dcsTag[4] = {'D', 'C', 'S', '1'};
+
+// Write a little-endian unsigned int
+static void writeUInt(ostream& out, unsigned int value)
+{
+	out.write((const char*)&value, sizeof(unsigned int));
+}
+
+// Writes the vertex array, index array and per-draw index counts
+static bool writeOutput(const string& filename, const DCStripifier& stripifier)
+{
+	ofstream out(filename.c_str(), ios::binary);
+
+	if(!out)
+		return false;
+
+	const std::vector<DCStripVertex>& vertices = stripifier.getVertices();
+	const std::vector<unsigned int>& indices = stripifier.getIndices();
+	const std::vector<unsigned int>& drawCounts = stripifier.getDrawCounts();
+
+	out.write(dcsTag, 4);
+	writeUInt(out, vertices.size());
+	writeUInt(out, indices.size());
+	writeUInt(out, drawCounts.size());
+
+	if(!vertices.empty())
+		out.write((const char*)&vertices[0], sizeof(DCStripVertex) * vertices.size());
+
+	if(!indices.empty())
+		out.write((const char*)&indices[0], sizeof(unsigned int) * indices.size());
+
+	for(unsigned int i = 0; i < drawCounts.size(); ++i)
+		writeUInt(out, drawCounts[i]);
+
+	return out.good();
+}
+
+// Print usage
+static void usage()
+{
+	cerr << "Usage: DCStripify [-list] [-restart | -stitch] [-notex] [-wide] [-noreorder] [-maxlength N] [-cache N [-lru] | -lookahead K | -tree] [-tunnel N [-tunneldepth D]] [-threads N] [-seeds N [-seedscore strips|indices|acmr]] [-meshlets V T] [-overdraw T] [-edit N] [-cachedir DIR [-verify]] [-json FILE] [-autotune] [-stream W] model.obj [output.dcs]" << endl;
+}
+
+// Patch of faces - breadth first over neighbours from the middle face
+static void selectPatch(const DCStripifier& stripifier, unsigned int numFaces, std::vector<unsigned int>& faces)
+{
+	const DCMesh& model = stripifier.getModel();
+	std::vector<bool> selected(model.getNumFaces(), false);
+
+	faces.clear();
+
+	if(!model.getNumFaces())
+		return;
+
+	faces.push_back(model.getNumFaces() / 2);
+	selected[faces[0]] = true;
+
+	for(unsigned int i = 0; i < faces.size() && faces.size() < numFaces; ++i)
+	{
+		EdgeIteratorT<VertexData, HalfEdgeData, FaceData> edgeIt(model.getFace(faces[i]));
+
+		for(int j = 0; j < 3 && faces.size() < numFaces; ++j)
+		{
+			DCMesh::Face* neighbour = edgeIt.getNext()->getTwin()->getFace();
+
+			if(neighbour && !selected[model.getFaceId(neighbour)])
+			{
+				selected[model.getFaceId(neighbour)] = true;
+				faces.push_back(model.getFaceId(neighbour));
+			}
+		}
+	}
+}
+
+// Prints an edit - time, indices patched and the triangles drawn after it
+static void printEdit(const char* label, const DCStripifier& stripifier, unsigned int numFaces, double seconds)
+{
+	unsigned int patched = 0;
+
+	for(unsigned int i = 0; i < stripifier.getPatchedRanges().size(); ++i)
+		patched += stripifier.getPatchedRanges()[i].count;
+
+	std::vector<unsigned int> triangles;
+	DCIndexStream::expandStrips(stripifier.getIndices(), stripifier.getDrawCounts(), DC_STRIP_CUT_32, triangles);
+
+	cout << label << numFaces << " faces, " << patched << " indices patched, " << triangles.size() / 3 << " triangles, " << seconds << "s" << endl;
+}
+
+// Wall clock seconds since start
+static double secondsSince(chrono::high_resolution_clock::time_point start)
+{
+	return chrono::duration_cast< chrono::duration<double> >(chrono::high_resolution_clock::now() - start).count();
+}
+
+// Reads a whole file
+static bool readFile(const string& filename, std::vector<char>& bytes)
+{
+	ifstream file(filename.c_str(), ios::binary);
+
+	if(file)
+	{
+		file.seekg(0, ios::end);
+		bytes.resize((unsigned int)file.tellg());
+		file.seekg(0, ios::beg);
+
+		if(!bytes.empty())
+			file.read(&bytes[0], bytes.size());
+	}
+
+	return file.good();
+}
+
+// Cached stripification - a hit skips loading and stripifying; verifying
+// compares the result with a fresh build
+static int runCached(const string& input, const string& directory, const DCStripSettings& settings, bool verify)
+{
+	std::vector<char> modelBytes;
+
+	if(!readFile(input, modelBytes))
+	{
+		cerr << "Can't read the file '" << input << "'" << endl;
+		return 1;
+	}
+
+	unsigned long long key = DCStripCache::makeKey(modelBytes, settings);
+	string filename = directory + "/" + DCStripCache::getFilename(key);
+
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	DCStripifier stripifier(settings);
+	DCMeshDef meshDef;
+	bool hit = false;
+
+	try
+	{
+		ifstream in(filename.c_str(), ios::binary);
+		hit = in && DCStripCache::load(in, key, stripifier);
+
+		if(!hit)
+		{
+			DCObjLoader::load(input, meshDef);
+			stripifier.loadMesh(meshDef);
+			stripifier.build();
+
+			ofstream out(filename.c_str(), ios::binary);
+
+			if(!out || !DCStripCache::save(out, key, stripifier))
+				cerr << "Can't write the file '" << filename << "'" << endl;
+		}
+	}
+	catch(const std::exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	double seconds = secondsSince(start);
+
+	cout << input << endl;
+	cout << "  cache file:   " << filename << endl;
+	cout << "  cache:        " << (hit ? "hit" : "miss") << ", " << seconds << "s" << endl;
+
+	if(!verify)
+		return 0;
+
+	// Fresh build
+	start = chrono::high_resolution_clock::now();
+
+	DCStripifier fresh(settings);
+
+	try
+	{
+		if(hit)
+			DCObjLoader::load(input, meshDef);
+
+		fresh.loadMesh(meshDef);
+		fresh.build();
+	}
+	catch(const std::exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	double freshSeconds = secondsSince(start);
+
+	bool matches = stripifier.getIndices() == fresh.getIndices() && stripifier.getDrawCounts() == fresh.getDrawCounts() &&
+		stripifier.getVertices().size() == fresh.getVertices().size() && stripifier.getStripSpans().size() == fresh.getStripSpans().size();
+
+	for(unsigned int i = 0; matches && i < fresh.getVertices().size(); ++i)
+		matches = !memcmp(&stripifier.getVertices()[i], &fresh.getVertices()[i], sizeof(DCStripVertex));
+
+	cout << "  fresh build:  " << freshSeconds << "s" << endl;
+	cout << "  matches:      " << (matches ? "yes" : "no") << endl;
+
+	return matches ? 0 : 1;
+}
+
+// Streamed stripification - the file is read twice, vertices then faces, and
+// strips are written as they leave the window; the counts are patched last
+static int runStream(const string& input, const string& output, const DCStripSettings& settings, unsigned int windowSize, const string& reportFile)
+{
+	try
+	{
+		DCStreamStripifier::checkSettings(settings);
+	}
+	catch(const std::exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	// Without an output file the strips are discarded
+	ofstream file;
+	ostream discard(NULL);
+
+	if(!output.empty())
+	{
+		file.open(output.c_str(), ios::binary);
+
+		if(!file)
+		{
+			cerr << "Can't write the file '" << output << "'" << endl;
+			return 1;
+		}
+	}
+
+	ostream& out = output.empty() ? discard : file;
+
+	out.write(dcsTag, 4);
+	writeUInt(out, 0);
+	writeUInt(out, 0);
+	writeUInt(out, 0);
+
+	DCObjStream obj;
+	DCStreamStripifier stripifier(out, windowSize, settings);
+
+	try
+	{
+		obj.open(input);
+
+		// Vertices - no normals or texture coordinates are streamed
+		DCStripVertex vertex;
+		memset(&vertex, 0, sizeof(DCStripVertex));
+
+		while(obj.nextVertex(vertex.pos))
+			out.write((const char*)&vertex, sizeof(DCStripVertex));
+
+		// Faces
+		obj.rewind();
+
+		unsigned int v[3];
+		unsigned int material;
+
+		while(obj.nextFace(v, material))
+			stripifier.addFace(v, material);
+
+		stripifier.finish();
+	}
+	catch(const std::exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	double seconds = secondsSince(start);
+
+	DCStripReport report = stripifier.getReport();
+	report.stripTime = seconds;
+
+	if(report.draws)
+		writeUInt(out, report.indices);
+
+	// Counts
+	out.seekp(4);
+	writeUInt(out, obj.getNumVertices());
+	writeUInt(out, report.indices);
+	writeUInt(out, report.draws);
+
+	unsigned long long windowBytes = 0;
+
+	for(unsigned int i = 0; i < report.memory.size(); ++i)
+		windowBytes += report.memory[i].peak;
+
+	// Summary
+	cout << input << endl;
+	cout << "  faces:        " << report.faces << " (" << stripifier.getNumDegenerates() << " degenerate skipped)" << endl;
+	cout << "  vertices:     " << obj.getNumVertices() << endl;
+	cout << "  strips:       " << report.strips << endl;
+	cout << "  indices:      " << report.indices << endl;
+	cout << "  join indices: " << report.joinIndices << endl;
+	cout << "  window:       " << windowSize << " faces, " << windowBytes << " bytes" << endl;
+	cout << "  time:         " << seconds << "s" << endl;
+
+	if(!reportFile.empty())
+	{
+		ofstream json(reportFile.c_str());
+		report.writeJSON(json);
+
+		if(!json)
+		{
+			cerr << "Can't write the file '" << reportFile << "'" << endl;
+			return 1;
+		}
+	}
+
+	if(!output.empty() && !file)
+	{
+		cerr << "Can't write the file '" << output << "'" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// Tunes the strip growth settings, prints the best candidates and saves the winner next to the model
+static bool runAutotune(const string& input, const DCMeshDef& meshDef, DCStripSettings& settings)
+{
+	DCTuneOptions options;
+	options.base = settings;
+	options.cacheType = settings.cacheType;
+	options.cacheSize = settings.cacheSize;
+
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	std::vector<DCTuneResult> results;
+	DCAutotuner::tune(meshDef, options, results);
+
+	if(results.empty())
+		return false;
+
+	cout << "autotune: " << results.size() << " candidates, " << secondsSince(start) << "s" << endl;
+
+	static const char* strategyNames[] = {"greedy", "cache", "lookahead", "tree"};
+
+	for(unsigned int i = 0; i < results.size() && i < 5; ++i)
+	{
+		const DCTuneResult& result = results[i];
+
+		cout << "  " << strategyNames[result.settings.strategy] << " maxLength " << result.settings.maxLength;
+
+		if(result.settings.strategy == DC_STRATEGY_CACHE)
+			cout << " cache " << result.settings.cacheSize;
+
+		cout << ": score " << result.score << ", " << result.indices << " indices, " << result.strips << " strips, ACMR " << result.acmr << endl;
+	}
+
+	settings = results[0].settings;
+
+	// Tuning file - keyed by the model bytes
+	std::vector<char> modelBytes;
+
+	if(!readFile(input, modelBytes))
+	{
+		cerr << "Can't read the file '" << input << "'" << endl;
+		return false;
+	}
+
+	string tuneFilename = input + DC_TUNE_EXTENSION;
+	ofstream out(tuneFilename.c_str());
+
+	if(!out || !DCAutotuner::save(out, DCAutotuner::makeKey(modelBytes), settings))
+	{
+		cerr << "Can't write the file '" << tuneFilename << "'" << endl;
+		return false;
+	}
+
+	cout << "  saved:        " << tuneFilename << endl;
+
+	return true;
+}
+
+// Main
+int main(int argc, char** argv)
+{
+	DCStripSettings settings;
+	string input;
+	string output;
+	unsigned int meshletVertices = 0;
+	unsigned int meshletTriangles = 0;
+	unsigned int editFaces = 0;
+	string cacheDirectory;
+	bool verify = false;
+	string reportFile;
+	bool autotune = false;
+	unsigned int streamWindow = 0;
+
+	// Parse arguments
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-list"))
+			settings.stripify = false;
+		else if(!strcmp(argv[i], "-restart"))
+			settings.output = DC_OUTPUT_RESTART;
+		else if(!strcmp(argv[i], "-stitch"))
+			settings.output = DC_OUTPUT_STITCHED;
+		else if(!strcmp(argv[i], "-notex"))
+			settings.useTextures = false;
+		else if(!strcmp(argv[i], "-wide"))
+			settings.indexFormat = DC_INDEX_32;
+		else if(!strcmp(argv[i], "-noreorder"))
+			settings.reorderVertices = false;
+		else if(!strcmp(argv[i], "-maxlength") && i + 1 < argc)
+			settings.maxLength = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-cache") && i + 1 < argc)
+		{
+			settings.strategy = DC_STRATEGY_CACHE;
+			settings.cacheSize = atoi(argv[++i]);
+		}
+		else if(!strcmp(argv[i], "-lru"))
+			settings.cacheType = DC_CACHE_LRU;
+		else if(!strcmp(argv[i], "-lookahead") && i + 1 < argc)
+		{
+			settings.strategy = DC_STRATEGY_LOOKAHEAD;
+			settings.lookAhead = atoi(argv[++i]);
+		}
+		else if(!strcmp(argv[i], "-tree"))
+			settings.strategy = DC_STRATEGY_TREE;
+		else if(!strcmp(argv[i], "-tunnel") && i + 1 < argc)
+			settings.tunnelIterations = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-tunneldepth") && i + 1 < argc)
+			settings.tunnelDepth = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-threads") && i + 1 < argc)
+			settings.threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-seeds") && i + 1 < argc)
+			settings.seedRuns = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-seedscore") && i + 1 < argc)
+		{
+			++i;
+
+			if(!strcmp(argv[i], "indices"))
+				settings.seedScore = DC_SEED_SCORE_INDICES;
+			else if(!strcmp(argv[i], "acmr"))
+				settings.seedScore = DC_SEED_SCORE_ACMR;
+			else if(!strcmp(argv[i], "strips"))
+				settings.seedScore = DC_SEED_SCORE_STRIPS;
+			else
+			{
+				usage();
+				return 1;
+			}
+		}
+		else if(!strcmp(argv[i], "-overdraw") && i + 1 < argc)
+		{
+			settings.orderOverdraw = true;
+			settings.overdrawThreshold = (float)atof(argv[++i]);
+		}
+		else if(!strcmp(argv[i], "-json") && i + 1 < argc)
+			reportFile = argv[++i];
+		else if(!strcmp(argv[i], "-cachedir") && i + 1 < argc)
+			cacheDirectory = argv[++i];
+		else if(!strcmp(argv[i], "-verify"))
+			verify = true;
+		else if(!strcmp(argv[i], "-autotune"))
+			autotune = true;
+		else if(!strcmp(argv[i], "-stream") && i + 1 < argc)
+			streamWindow = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-edit") && i + 1 < argc)
+			editFaces = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-meshlets") && i + 2 < argc)
+		{
+			meshletVertices = atoi(argv[++i]);
+			meshletTriangles = atoi(argv[++i]);
+		}
+		else if(argv[i][0] == '-')
+		{
+			usage();
+			return 1;
+		}
+		else if(input.empty())
+			input = argv[i];
+		else
+			output = argv[i];
+	}
+
+	if(input.empty())
+	{
+		usage();
+		return 1;
+	}
+
+	if(streamWindow)
+	{
+		// Vertices are written as they are read - nothing to reorder, cut or edit
+		if(settings.reorderVertices || meshletVertices || editFaces || !cacheDirectory.empty() || autotune)
+		{
+			cerr << "-stream needs -noreorder, and takes no -meshlets, -edit, -cachedir or -autotune" << endl;
+			return 1;
+		}
+
+		return runStream(input, output, settings, streamWindow, reportFile);
+	}
+
+	if(!cacheDirectory.empty())
+		return runCached(input, cacheDirectory, settings, verify);
+
+	DCMeshDef meshDef;
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+
+	try
+	{
+		DCObjLoader::load(input, meshDef);
+	}
+	catch(const std::exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	double importSeconds = secondsSince(start);
+
+	// Autotune - the winner replaces the strip growth settings
+	if(autotune && settings.stripify)
+	{
+		if(!runAutotune(input, meshDef, settings))
+			return 1;
+	}
+
+	// Stripify
+	start = chrono::high_resolution_clock::now();
+
+	DCStripifier stripifier(settings);
+	stripifier.loadMesh(meshDef);
+	stripifier.build();
+
+	double seconds = secondsSince(start);
+
+	// Report - before any edit changes the output
+	DCStripReport report = stripifier.getReport();
+	report.importTime = importSeconds;
+
+	// Summary
+	cout << input << endl;
+	cout << "  faces:        " << stripifier.getModel().getNumFaces() << endl;
+	cout << "  vertices:     " << stripifier.getVertices().size() << " (" << stripifier.getNumDuplications() << " duplicated)" << endl;
+	cout << "  strips:       " << stripifier.getNumStrips();
+
+	if(settings.stripify && settings.tunnelIterations)
+		cout << " (" << stripifier.getNumStripsBeforeTunnelling() << " before tunnelling)";
+
+	cout << endl;
+	cout << "  indices:      " << stripifier.getIndices().size() << endl;
+	cout << "  draws:        " << stripifier.getDrawCounts().size() << endl;
+	cout << "  submeshes:    " << stripifier.getSubmeshes().size() << endl;
+	cout << "  join indices: " << stripifier.getNumJoinIndices() << endl;
+
+	// Index buffer size as uploaded
+	DCPackedIndices packed;
+	DCIndexPacker::pack(stripifier.getIndices(), stripifier.getDrawCounts(), settings.stripify, settings.indexFormat, packed);
+
+	cout << "  index bytes:  " << packed.getBytes() << " (" << (packed.format == DC_INDEX_16 ? 16 : 32) << "-bit, "
+		<< packed.draws.size() << " draws, " << stripifier.getIndices().size() * sizeof(unsigned int) << " as 32-bit)" << endl;
+
+	// Expand the strips back into triangles to check the output
+	if(settings.stripify)
+	{
+		std::vector<unsigned int> triangles;
+		DCIndexStream::expandStrips(stripifier.getIndices(), stripifier.getDrawCounts(), DC_STRIP_CUT_32, triangles);
+
+		cout << "  triangles:    " << triangles.size() / 3 << endl;
+	}
+	cout << "  time:         " << seconds << "s" << endl;
+
+	// Region boundary loss - compare against a single region
+	if(settings.stripify && settings.threads > 1)
+	{
+		DCStripSettings serialSettings = settings;
+		serialSettings.threads = 1;
+
+		start = chrono::high_resolution_clock::now();
+
+		DCStripifier serial(serialSettings);
+		serial.loadMesh(meshDef);
+		serial.build();
+
+		double serialSeconds = secondsSince(start);
+
+		double share = (double)stripifier.getModel().getNumFaces() / settings.threads;
+
+		cout << "  regions:      " << settings.threads << " (" << stripifier.getNumRegionCuts() << " edges cut, largest "
+			<< stripifier.getLargestRegion() << " faces, " << stripifier.getLargestRegion() / share << "x its share)" << endl;
+		cout << "  serial:       " << serial.getNumStrips() << " strips, " << serial.getIndices().size() << " indices, " << serialSeconds << "s" << endl;
+		cout << "  region loss:  " << (int)stripifier.getNumStrips() - (int)serial.getNumStrips() << " strips, "
+			<< (int)stripifier.getIndices().size() - (int)serial.getIndices().size() << " indices" << endl;
+	}
+
+	// Vertex fetch scatter - against file order when reordered
+	DCCacheReport fetch = DCCacheMetrics::measure(stripifier, settings.cacheType, settings.cacheSize);
+
+	cout << "  fetch lines:  " << fetch.fetchLines << " (average distance " << fetch.fetchDistance << " vertices)" << endl;
+
+	if(settings.reorderVertices && !report.cached)
+		cout << "  file order:   " << report.fetchLinesBefore << " (average distance " << report.fetchDistanceBefore << " vertices)" << endl;
+
+	// Overdraw estimate - against strip order when ordered
+	DCOverdrawReport overdraw = DCOverdraw::measure(stripifier);
+
+	cout << "  overdraw:     " << overdraw.overdraw << " (" << overdraw.views << " views, ACMR " << fetch.acmr << ")" << endl;
+
+	if(settings.stripify && settings.orderOverdraw)
+	{
+		DCStripSettings unorderedSettings = settings;
+		unorderedSettings.orderOverdraw = false;
+
+		DCStripifier unordered(unorderedSettings);
+		unordered.loadMesh(meshDef);
+		unordered.build();
+
+		cout << "  strip order:  " << DCOverdraw::measure(unordered).overdraw << " (ACMR "
+			<< DCCacheMetrics::measure(unordered, settings.cacheType, settings.cacheSize).acmr << ")" << endl;
+	}
+
+	// Meshlets
+	if(meshletVertices)
+	{
+		DCMeshletBuilder meshlets;
+		meshlets.build(stripifier, meshletVertices, meshletTriangles);
+
+		unsigned int numMeshlets = meshlets.getMeshlets().size();
+		unsigned int cones = 0;
+
+		for(unsigned int i = 0; i < numMeshlets; ++i)
+			if(meshlets.getMeshlets()[i].coneCutoff > 0)
+				cones += 1;
+
+		cout << "  meshlets:     " << numMeshlets << " (" << cones << " with normal cones)" << endl;
+
+		if(numMeshlets)
+			cout << "  per meshlet:  " << (float)meshlets.getVertices().size() / numMeshlets << " vertices, "
+				<< (float)meshlets.getTriangles().size() / 3 / numMeshlets << " triangles" << endl;
+	}
+
+	// Incremental edits - a hole cut in the middle of the mesh, then filled again
+	if(editFaces && settings.stripify)
+	{
+		DCMeshEdit edit;
+		selectPatch(stripifier, editFaces, edit.removed);
+
+		start = chrono::high_resolution_clock::now();
+		stripifier.editMesh(edit);
+		printEdit("  removed:      ", stripifier, edit.removed.size(), secondsSince(start));
+
+		edit.added.swap(edit.removed);
+
+		start = chrono::high_resolution_clock::now();
+		stripifier.editMesh(edit);
+		printEdit("  restored:     ", stripifier, edit.added.size(), secondsSince(start));
+	}
+
+	if(!reportFile.empty())
+	{
+		ofstream out(reportFile.c_str());
+		report.writeJSON(out);
+
+		if(!out)
+		{
+			cerr << "Can't write the file '" << reportFile << "'" << endl;
+			return 1;
+		}
+	}
+
+	if(!output.empty() && !writeOutput(output, stripifier))
+	{
+		cerr << "Can't write the file '" << output << "'" << endl;
+		return 1;
+	}
+
+	return 0;
+}